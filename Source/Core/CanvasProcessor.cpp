@@ -1,154 +1,364 @@
-#include "CanvasProcessor.h"
-#include <JuceHeader.h>
-#include <cmath>
-
-
-CanvasProcessor::CanvasProcessor()
-{
-    // Pre-allocate the vector to its maximum size to avoid reallocations
-    oscillators.resize(maxPartials);
-}
-
-CanvasProcessor::~CanvasProcessor() = default;
-
-void CanvasProcessor::prepareToPlay(double sr, int samplesPerBlock)
-{
-    sampleRate = static_cast<float>(sr);
-    masterGain.reset(sampleRate, 0.01); // 10ms smoothing time
-    masterGain.setCurrentAndTargetValue(1.0f);
-
-    for (auto& osc : oscillators)
-    {
-        osc.phase = 0.0f;
-        osc.amplitude = 0.0f;
-        osc.targetAmplitude = 0.0f;
-    }
-}
-
-void CanvasProcessor::processBlock(juce::AudioBuffer<float>& buffer)
-{
-    if (!isActive || !currentImage.isValid())
-    {
-        buffer.clear();
-        return;
-    }
-
-    const int numSamples = buffer.getNumSamples();
-    const int numChannels = buffer.getNumChannels();
-
-    // Update oscillator properties from the image column once per block
-    const int currentColumn = juce::jlimit(0, imageWidth - 1, static_cast<int>(playheadPos * imageWidth));
-    updateOscillatorsFromColumn(currentColumn);
-
-    // Get raw pointers to buffer channels for efficient writing
-    auto* leftChannel = buffer.getWritePointer(0);
-    auto* rightChannel = numChannels > 1 ? buffer.getWritePointer(1) : nullptr;
-
-    for (int sample = 0; sample < numSamples; ++sample)
-    {
-        float leftSample = 0.0f;
-        float rightSample = 0.0f;
-
-        // --- SINGLE-PASS RENDER LOOP ---
-        for (auto& osc : oscillators)
-        {
-            // Only process audible oscillators
-            if (osc.targetAmplitude > 0.0001f || osc.amplitude > 0.0001f)
-            {
-                // Smooth amplitude changes to prevent clicks/zippering
-                osc.amplitude += (osc.targetAmplitude - osc.amplitude) * 0.05f;
-
-                const float oscSample = osc.getSample() * osc.amplitude;
-
-                if (usePanning && rightChannel != nullptr)
-                {
-                    leftSample += oscSample * (1.0f - osc.pan);
-                    rightSample += oscSample * osc.pan;
-                }
-                else // Mono or panning is disabled
-                {
-                    leftSample += oscSample;
-                }
-
-                // Advance phase for the next sample
-                osc.updatePhase(osc.frequency / sampleRate);
-            }
-        }
-
-        const float currentGain = masterGain.getNextValue() * amplitudeScale;
-
-        // Write the final computed sample to the output buffer
-        leftChannel[sample] = leftSample * currentGain;
-
-        if (rightChannel != nullptr)
-        {
-            // If panning was disabled, copy the left sample. Otherwise, use the calculated right sample.
-            rightChannel[sample] = usePanning ? (rightSample * currentGain) : leftChannel[sample];
-        }
-    }
-}
-
-void CanvasProcessor::updateFromImage(const juce::Image& image)
-{
-    currentImage = image;
-    imageWidth = image.getWidth();
-    imageHeight = image.getHeight();
-
-    // Reset all oscillators when a new image is loaded
-    for (auto& osc : oscillators)
-    {
-        osc.amplitude = 0.0f;
-        osc.targetAmplitude = 0.0f;
-    }
-}
-
-void CanvasProcessor::updateOscillatorsFromColumn(int x)
-{
-    if (!currentImage.isValid() || x < 0 || x >= imageWidth)
-        return;
-
-    // Use jmax to prevent division by zero if image is tiny
-    const int step = juce::jmax(1, imageHeight / maxPartials);
-    int oscIndex = 0;
-
-    const bool isColor = currentImage.getFormat() != juce::Image::PixelFormat::SingleChannel;
-
-
-    for (int y = 0; y < imageHeight && oscIndex < maxPartials; y += step, ++oscIndex)
-    {
-        auto pixel = currentImage.getPixelAt(x, y);
-        auto& osc = oscillators[oscIndex];
-
-        // Map Y-axis to frequency
-        osc.frequency = pixelYToFrequency(y);
-
-        // Map brightness to target amplitude
-        osc.targetAmplitude = pixel.getBrightness();
-
-        // Map hue to pan only if the image is in color
-        osc.pan = isColor ? pixel.getHue() : 0.5f;
-    }
-}
-
-float CanvasProcessor::pixelYToFrequency(int y) const
-{
-    // Logarithmic mapping of pixel Y to frequency for a more musical result
-    // Invert Y so that top of image is high frequency
-    const float normalisedY = 1.0f - (static_cast<float>(y) / static_cast<float>(imageHeight));
-
-    // Convert linear (0-1) to logarithmic frequency scale
-    const float logMin = std::log(minFreq);
-    const float logMax = std::log(maxFreq);
-    return std::exp(logMin + normalisedY * (logMax - logMin));
-}
-
-void CanvasProcessor::setFrequencyRange(float minHz, float maxHz)
-{
-    minFreq = juce::jlimit(20.0f, 20000.0f, minHz);
-    maxFreq = juce::jlimit(minFreq, 22000.0f, maxHz);
-}
-
-void CanvasProcessor::setPlayheadPosition(float normalisedPosition)
-{
-    playheadPos = juce::jlimit(0.0f, 1.0f, normalisedPosition);
+#include "CanvasProcessor.h"
+#include <JuceHeader.h>
+#include <cmath>
+
+
+CanvasProcessor::CanvasProcessor()
+{
+    // Pre-allocate the vector to its maximum size to avoid reallocations
+    oscillators.resize(maxPartials);
+    columnAmplitude.resize(maxPartials);
+    columnPan.resize(maxPartials);
+    activeRows.reserve(maxPartials);
+    previousRows.reserve(maxPartials);
+    rowIsActive.resize(maxPartials, 0);
+}
+
+CanvasProcessor::~CanvasProcessor() = default;
+
+void CanvasProcessor::prepareToPlay(double sr, int samplesPerBlock)
+{
+    sampleRate = static_cast<float>(sr);
+    masterGain.reset(sampleRate, 0.01); // 10ms smoothing time
+    masterGain.setCurrentAndTargetValue(1.0f);
+
+    for (auto& osc : oscillators)
+    {
+        osc.phase = 0.0f;
+        osc.amplitude = 0.0f;
+        osc.targetAmplitude = 0.0f;
+        osc.amplitudeStep = 0.0f;
+    }
+
+    activeRows.clear();
+    samplesUntilControl = 0;
+    setSweepDuration(sweepSeconds);
+}
+
+void CanvasProcessor::processBlock(juce::AudioBuffer<float>& buffer)
+{
+    if (!isActive || image.width == 0)
+    {
+        buffer.clear();
+        return;
+    }
+
+    const int numSamples = buffer.getNumSamples();
+    const int numChannels = buffer.getNumChannels();
+
+    // Get raw pointers to buffer channels for efficient writing
+    auto* leftChannel = buffer.getWritePointer(0);
+    auto* rightChannel = numChannels > 1 ? buffer.getWritePointer(1) : nullptr;
+
+    // Split the block at control points, whatever the block size
+    for (int sample = 0; sample < numSamples;)
+    {
+        if (samplesUntilControl == 0)
+        {
+            // Aim each ramp at where the playhead will be by the next control point
+            updateOscillatorsFromPlayhead(playheadPos + controlInterval * sweepIncrement);
+            samplesUntilControl = controlInterval;
+        }
+
+        const int num = juce::jmin(samplesUntilControl, numSamples - sample);
+        renderSpan(leftChannel + sample, rightChannel != nullptr ? rightChannel + sample : nullptr, num);
+
+        playheadPos += num * sweepIncrement;
+        if (playheadPos >= 1.0)
+            playheadPos -= std::floor(playheadPos);
+
+        samplesUntilControl -= num;
+        sample += num;
+    }
+}
+
+void CanvasProcessor::renderSpan(float* leftChannel, float* rightChannel, int numSamples)
+{
+    for (int sample = 0; sample < numSamples; ++sample)
+    {
+        float leftSample = 0.0f;
+        float rightSample = 0.0f;
+
+        // --- SINGLE-PASS RENDER LOOP ---
+        for (const int row : activeRows)
+        {
+            auto& osc = oscillators[(size_t)row];
+
+            // Only process audible oscillators
+            if (osc.targetAmplitude > 0.0001f || osc.amplitude > 0.0001f)
+            {
+                // Linear ramp towards the crossfaded column, so column changes don't click
+                osc.amplitude += osc.amplitudeStep;
+
+                const float oscSample = osc.getSample() * osc.amplitude;
+
+                if (usePanning && rightChannel != nullptr)
+                {
+                    leftSample += oscSample * (1.0f - osc.pan);
+                    rightSample += oscSample * osc.pan;
+                }
+                else // Mono or panning is disabled
+                {
+                    leftSample += oscSample;
+                }
+
+                // Advance phase for the next sample
+                osc.updatePhase(osc.frequency / sampleRate);
+            }
+        }
+
+        const float currentGain = masterGain.getNextValue() * amplitudeScale;
+
+        // Write the final computed sample to the output buffer
+        leftChannel[sample] = leftSample * currentGain;
+
+        if (rightChannel != nullptr)
+        {
+            // If panning was disabled, copy the left sample. Otherwise, use the calculated right sample.
+            rightChannel[sample] = usePanning ? (rightSample * currentGain) : leftChannel[sample];
+        }
+    }
+}
+
+bool CanvasProcessor::prepareImage(const juce::Image& source, PreparedImage& dest)
+{
+    if (!source.isValid())
+        return false;
+
+    const int width = source.getWidth();
+    const int height = source.getHeight();
+
+    // Use jmax to prevent division by zero if image is tiny
+    const int step = juce::jmax(1, height / maxPartials);
+    const int numRows = juce::jmin(maxPartials, (height + step - 1) / step);
+
+    dest.width = width;
+    dest.numRows = numRows;
+    dest.sourceHeight = height;
+    dest.rowStep = step;
+    dest.amplitude.assign((size_t)width * (size_t)numRows, 0.0f);
+    dest.pan.assign((size_t)width * (size_t)numRows, 0.5f);
+
+    const bool isColor = source.getFormat() != juce::Image::PixelFormat::SingleChannel;
+    const juce::Image::BitmapData pixels(source, juce::Image::BitmapData::readOnly);
+
+    // Row by row keeps the source reads sequential; the writes stride by numRows
+    for (int row = 0; row < numRows; ++row)
+    {
+        const int y = row * step;
+
+        for (int x = 0; x < width; ++x)
+        {
+            const auto pixel = pixels.getPixelColour(x, y);
+            const size_t index = (size_t)x * (size_t)numRows + (size_t)row;
+
+            // Map brightness to amplitude, and hue to pan only if the image is in color
+            dest.amplitude[index] = pixel.getBrightness();
+            if (isColor)
+                dest.pan[index] = pixel.getHue();
+        }
+    }
+
+    dest.findRuns();
+    return true;
+}
+
+void CanvasProcessor::PreparedImage::findRuns()
+{
+    runs.clear();
+    columnRuns.resize((size_t)width + 1);
+
+    for (int x = 0; x < width; ++x)
+    {
+        columnRuns[(size_t)x] = (juce::uint32)runs.size();
+        CanvasRun::find(getAmplitudeColumn(x), numRows, runs);
+    }
+
+    columnRuns[(size_t)width] = (juce::uint32)runs.size();
+}
+
+bool CanvasProcessor::prepareTiledImage(const juce::File& tileFile, PreparedImage& dest, bool deleteFileWhenClosed)
+{
+    auto tiles = std::make_unique<TiledCanvas>();
+    if (!tiles->open(tileFile, deleteFileWhenClosed) || tiles->getNumRows() > maxPartials)
+        return false;
+
+    dest.amplitude.clear();
+    dest.pan.clear();
+    dest.runs.clear();
+    dest.columnRuns.clear();
+    dest.width = tiles->getWidth();
+    dest.numRows = tiles->getNumRows();
+    dest.sourceHeight = tiles->getSourceHeight();
+    dest.rowStep = tiles->getRowStep();
+    dest.tiles = std::move(tiles);
+    return true;
+}
+
+void CanvasProcessor::installImage(PreparedImage& newImage)
+{
+    std::swap(image, newImage);
+    updateRowFrequencies();
+
+    // Reset all oscillators when a new image is loaded
+    for (auto& osc : oscillators)
+    {
+        osc.amplitude = 0.0f;
+        osc.targetAmplitude = 0.0f;
+        osc.amplitudeStep = 0.0f;
+        osc.pan = 0.5f;
+    }
+
+    activeRows.clear();
+    samplesUntilControl = 0;
+    setSweepDuration(sweepSeconds);
+}
+
+void CanvasProcessor::updateOscillatorsFromPlayhead(double position)
+{
+    const bool sweeping = sweepIncrement > 0.0;
+    const double column = (sweeping ? position - std::floor(position) : position) * image.width;
+    const int column0 = juce::jlimit(0, image.width - 1, static_cast<int>(column));
+    const float fraction = juce::jlimit(0.0f, 1.0f, static_cast<float>(column - column0));
+
+    // A sweeping playhead wraps from the last column back into the first
+    const int column1 = sweeping ? (column0 + 1) % image.width
+                                 : juce::jmin(column0 + 1, image.width - 1);
+
+    TiledCanvas::ColumnView view0, view1;
+
+    if (image.tiles != nullptr)
+    {
+        image.tiles->setPlayheadColumn(column0);
+        view0 = image.tiles->acquireColumn(column0);
+        view1 = image.tiles->acquireColumn(column1);
+
+        // Not streamed in yet: hold the current column rather than wait for the disk
+        if (view0.amplitude == nullptr || view1.amplitude == nullptr)
+        {
+            image.tiles->releaseColumn(view0);
+            image.tiles->releaseColumn(view1);
+
+            for (const int row : activeRows)
+            {
+                auto& osc = oscillators[(size_t)row];
+                osc.amplitude = osc.targetAmplitude;
+                osc.amplitudeStep = 0.0f;
+            }
+            return;
+        }
+    }
+    else
+    {
+        view0 = image.getColumn(column0);
+        view1 = image.getColumn(column1);
+    }
+
+    // Painted rows of either column get the crossfade; nothing else is touched
+    std::swap(activeRows, previousRows);
+    activeRows.clear();
+
+    crossfadeRuns(view0, view1, view0, fraction);
+    crossfadeRuns(view0, view1, view1, fraction);
+
+    if (image.tiles != nullptr)
+    {
+        image.tiles->releaseColumn(view0);
+        image.tiles->releaseColumn(view1);
+    }
+
+    // Rows that were sounding and aren't painted here any more fade out over one interval.
+    // Rows whose last ramp already reached silence drop out.
+    for (const int row : previousRows)
+    {
+        if (rowIsActive[(size_t)row])
+            continue;
+
+        auto& osc = oscillators[(size_t)row];
+        if (osc.targetAmplitude > 0.0f)
+        {
+            columnAmplitude[(size_t)row] = 0.0f;
+            columnPan[(size_t)row] = osc.pan;
+            rowIsActive[(size_t)row] = 1;
+            activeRows.push_back(row);
+        }
+        else
+        {
+            osc.amplitude = 0.0f;
+            osc.amplitudeStep = 0.0f;
+        }
+    }
+
+    constexpr float rampScale = 1.0f / controlInterval;
+
+    for (const int row : activeRows)
+    {
+        auto& osc = oscillators[(size_t)row];
+        osc.amplitude = osc.targetAmplitude;   // where the last ramp was heading
+        osc.targetAmplitude = columnAmplitude[(size_t)row];
+        osc.amplitudeStep = (osc.targetAmplitude - osc.amplitude) * rampScale;
+        osc.pan = columnPan[(size_t)row];
+        rowIsActive[(size_t)row] = 0;
+    }
+}
+
+void CanvasProcessor::crossfadeRuns(const TiledCanvas::ColumnView& view0, const TiledCanvas::ColumnView& view1,
+                                    const TiledCanvas::ColumnView& runSource, float fraction)
+{
+    for (int r = 0; r < runSource.numRuns; ++r)
+    {
+        const int first = runSource.runs[r].firstRow;
+        const int num = runSource.runs[r].numRows;
+
+        // Runs of the two columns may overlap; the result is the same either way
+        juce::FloatVectorOperations::multiply(columnAmplitude.data() + first, view0.amplitude + first, 1.0f - fraction, num);
+        juce::FloatVectorOperations::addWithMultiply(columnAmplitude.data() + first, view1.amplitude + first, fraction, num);
+        juce::FloatVectorOperations::multiply(columnPan.data() + first, view0.pan + first, 1.0f - fraction, num);
+        juce::FloatVectorOperations::addWithMultiply(columnPan.data() + first, view1.pan + first, fraction, num);
+
+        for (int row = first; row < first + num; ++row)
+        {
+            if (!rowIsActive[(size_t)row])
+            {
+                rowIsActive[(size_t)row] = 1;
+                activeRows.push_back(row);
+            }
+        }
+    }
+}
+
+void CanvasProcessor::updateRowFrequencies()
+{
+    for (int row = 0; row < image.numRows; ++row)
+        oscillators[(size_t)row].frequency = pixelYToFrequency(row * image.rowStep);
+}
+
+float CanvasProcessor::pixelYToFrequency(int y) const
+{
+    // Logarithmic mapping of pixel Y to frequency for a more musical result
+    // Invert Y so that top of image is high frequency
+    const float normalisedY = 1.0f - (static_cast<float>(y) / static_cast<float>(image.sourceHeight));
+
+    // Convert linear (0-1) to logarithmic frequency scale
+    const float logMin = std::log(minFreq);
+    const float logMax = std::log(maxFreq);
+    return std::exp(logMin + normalisedY * (logMax - logMin));
+}
+
+void CanvasProcessor::setFrequencyRange(float minHz, float maxHz)
+{
+    minFreq = juce::jlimit(20.0f, 20000.0f, minHz);
+    maxFreq = juce::jlimit(minFreq, 22000.0f, maxHz);
+    updateRowFrequencies();
+}
+
+void CanvasProcessor::setPlayheadPosition(float normalisedPosition)
+{
+    playheadPos = juce::jlimit(0.0, 1.0, static_cast<double>(normalisedPosition));
+}
+
+void CanvasProcessor::setSweepDuration(float seconds)
+{
+    sweepSeconds = juce::jmax(0.0f, seconds);
+    sweepIncrement = sweepSeconds > 0.0f ? 1.0 / (sweepSeconds * sampleRate) : 0.0;
 }
\ No newline at end of file
@@ -1,69 +1,123 @@
-    #pragma once
-    #include <JuceHeader.h>
-
-    class CanvasProcessor
-    {
-    public:
-        CanvasProcessor();
-        ~CanvasProcessor();
-
-        void prepareToPlay(double sampleRate, int samplesPerBlock);
-        void processBlock(juce::AudioBuffer<float>& buffer);
-        void updateFromImage(const juce::Image& image);
-
-        // --- Control Methods ---
-        void setActive(bool shouldBeActive) { isActive = shouldBeActive; }
-        void setPlayheadPosition(float normalisedPosition);
-        void setFrequencyRange(float minHz, float maxHz);
-        void setMasterGain(float gain) { masterGain.setTargetValue(gain); }
-        void setAmplitudeScale(float scale) { amplitudeScale = scale; }
-        void setUsePanning(bool shouldUsePanning) { usePanning = shouldUsePanning; }
-
-    private:
-        // Nested struct for a single sine wave partial
-        struct Partial
-        {
-            float frequency = 0.0f;
-            float phase = 0.0f;
-            float amplitude = 0.0f;
-            float targetAmplitude = 0.0f;
-            float pan = 0.5f; // 0.0 = left, 0.5 = center, 1.0 = right
-
-            float getSample() const
-            {
-                return std::sin(phase * juce::MathConstants<float>::twoPi);
-            }
-
-            void updatePhase(float phaseIncrement)
-            {
-                phase += phaseIncrement;
-                if (phase >= 1.0f)
-                    phase -= 1.0f;
-            }
-        };
-
-        // Main DSP methods
-        void updateOscillatorsFromColumn(int x);
-        float pixelYToFrequency(int y) const;
-
-        // Member Variables
-        juce::Image currentImage;
-        std::vector<Partial> oscillators;
-
-        // Parameters
-        float sampleRate = 44100.0f;
-        float playheadPos = 0.0f;
-        int imageWidth = 0;
-        int imageHeight = 0;
-
-        bool isActive = false;
-        bool usePanning = true;
-
-        // Configurable settings
-        int maxPartials = 512;
-        float minFreq = 20.0f;
-        float maxFreq = 20000.0f;
-        float amplitudeScale = 1.0f; // Final scaling factor for amplitude
-
-        juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> masterGain;
+    #pragma once
+    #include <JuceHeader.h>
+    #include <memory>
+    #include <vector>
+    #include "TiledCanvas.h"
+
+    class CanvasProcessor
+    {
+    public:
+        static constexpr int maxPartials = 512;
+
+        // An image converted for synthesis. One row per partial, stored column-major
+        // so the column under the playhead is a contiguous run of floats.
+        // A canvas too long for memory streams its columns from tiles instead.
+        struct PreparedImage
+        {
+            std::vector<float> amplitude;   // brightness, [column * numRows + row]
+            std::vector<float> pan;         // hue, or centre for greyscale images
+            std::vector<CanvasRun> runs;            // painted rows of every column
+            std::vector<juce::uint32> columnRuns;   // column x's runs are [columnRuns[x], columnRuns[x + 1])
+            std::unique_ptr<TiledCanvas> tiles;   // set instead of amplitude, pan and runs
+            int width = 0;
+            int numRows = 0;
+            int sourceHeight = 0;
+            int rowStep = 1;                // source pixel rows per partial
+
+            const float* getAmplitudeColumn(int x) const noexcept { return amplitude.data() + (size_t)x * (size_t)numRows; }
+            const float* getPanColumn(int x) const noexcept       { return pan.data() + (size_t)x * (size_t)numRows; }
+
+            void findRuns();   // indexes the painted rows of every column
+
+            TiledCanvas::ColumnView getColumn(int x) const noexcept
+            {
+                const auto firstRun = columnRuns[(size_t)x];
+                return { getAmplitudeColumn(x), getPanColumn(x), runs.data() + firstRun, (int)(columnRuns[(size_t)x + 1] - firstRun) };
+            }
+        };
+
+        CanvasProcessor();
+        ~CanvasProcessor();
+
+        void prepareToPlay(double sampleRate, int samplesPerBlock);
+        void processBlock(juce::AudioBuffer<float>& buffer);
+
+        // Any thread but the audio thread; reads every pixel once. False for an invalid image.
+        static bool prepareImage(const juce::Image& image, PreparedImage& dest);
+        // Message thread; opens a tile file written by CanvasTileWriter and starts prefetching it
+        static bool prepareTiledImage(const juce::File& tileFile, PreparedImage& dest, bool deleteFileWhenClosed = false);
+        // Audio thread; swaps the matrix in, leaving the previous one in image to be freed elsewhere
+        void installImage(PreparedImage& image);
+
+        // --- Control Methods ---
+        void setActive(bool shouldBeActive) { isActive = shouldBeActive; }
+        bool isProducingAudio() const { return isActive && image.width > 0; }
+        void setPlayheadPosition(float normalisedPosition);
+        // Seconds for the playhead to cross the image, then wrap; 0 holds it where it was put
+        void setSweepDuration(float seconds);
+        void setFrequencyRange(float minHz, float maxHz);
+        void setMasterGain(float gain) { masterGain.setTargetValue(gain); }
+        void setAmplitudeScale(float scale) { amplitudeScale = scale; }
+        void setUsePanning(bool shouldUsePanning) { usePanning = shouldUsePanning; }
+
+    private:
+        // Nested struct for a single sine wave partial
+        struct Partial
+        {
+            float frequency = 0.0f;
+            float phase = 0.0f;
+            float amplitude = 0.0f;
+            float targetAmplitude = 0.0f;
+            float amplitudeStep = 0.0f; // per sample, reaching targetAmplitude at the next control point
+            float pan = 0.5f; // 0.0 = left, 0.5 = center, 1.0 = right
+
+            float getSample() const
+            {
+                return std::sin(phase * juce::MathConstants<float>::twoPi);
+            }
+
+            void updatePhase(float phaseIncrement)
+            {
+                phase += phaseIncrement;
+                if (phase >= 1.0f)
+                    phase -= 1.0f;
+            }
+        };
+
+        // Main DSP methods
+        void renderSpan(float* left, float* right, int numSamples);
+        void updateOscillatorsFromPlayhead(double position);
+        void crossfadeRuns(const TiledCanvas::ColumnView& view0, const TiledCanvas::ColumnView& view1,
+                           const TiledCanvas::ColumnView& runSource, float fraction);
+        void updateRowFrequencies();
+        float pixelYToFrequency(int y) const;
+
+        // Member Variables
+        PreparedImage image;
+        std::vector<Partial> oscillators;
+        std::vector<float> columnAmplitude, columnPan;   // the crossfaded column, one per row
+
+        // Partials painted in the current or the previous column; the only ones updated or rendered
+        std::vector<int> activeRows, previousRows;
+        std::vector<juce::uint8> rowIsActive;
+
+        // The image is read every controlInterval samples and amplitudes ramp linearly in between
+        static constexpr int controlInterval = 32;
+        int samplesUntilControl = 0;
+
+        // Parameters
+        float sampleRate = 44100.0f;
+        double playheadPos = 0.0;       // 0..1 across the image
+        double sweepIncrement = 0.0;    // playhead advance per sample
+        float sweepSeconds = 0.0f;
+
+        bool isActive = false;
+        bool usePanning = true;
+
+        // Configurable settings
+        float minFreq = 20.0f;
+        float maxFreq = 20000.0f;
+        float amplitudeScale = 1.0f; // Final scaling factor for amplitude
+
+        juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> masterGain;
     };  
\ No newline at end of file
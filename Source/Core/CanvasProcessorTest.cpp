@@ -0,0 +1,310 @@
+#include "CanvasProcessor.h"
+#include <JuceHeader.h>
+#include <cmath>
+#include <vector>
+
+/**
+ * Render tests for CanvasProcessor.
+ * Run after touching the control-rate crossfade or the active-row bookkeeping:
+ * output must not depend on the host's block size, and skipping unpainted
+ * rows must sound the same as updating every row.
+ */
+class CanvasProcessorTest
+{
+public:
+    static bool runBasicTests()
+    {
+        DBG("=== CanvasProcessor Render Tests ===");
+
+        // Test 1: Output doesn't depend on how the host slices its blocks
+        if (!testBlockSizeIndependence())
+            return false;
+
+        // Test 2: Updating painted rows only matches updating every row
+        if (!testMatchesDensePath())
+            return false;
+
+        // Test 3: Rows that stop being painted fade out and drop
+        if (!testUnpaintedRowsFallSilent())
+            return false;
+
+        DBG("=== All CanvasProcessor tests passed! ===");
+        return true;
+    }
+
+private:
+    static constexpr double sampleRate = 44100.0;
+    static constexpr float sweepSeconds = 0.2f;
+    static constexpr int numSamples = 20000;   // a little over two sweeps, so the wrap is covered
+    static constexpr int controlInterval = 32;   // as CanvasProcessor
+
+    // Greyscale like prepareImage makes of a SingleChannel image: sparse strokes that start,
+    // stop and restart, some a single column long, so rows keep joining and leaving the active list
+    static void makeSparseImage(CanvasProcessor::PreparedImage& image)
+    {
+        image.width = 48;
+        image.numRows = 64;
+        image.sourceHeight = 64;
+        image.rowStep = 1;
+        image.amplitude.assign((size_t)(image.width * image.numRows), 0.0f);
+        image.pan.assign((size_t)(image.width * image.numRows), 0.5f);
+
+        juce::Random random(0xca4a5);
+
+        for (int row = 0; row < image.numRows; row += 3)
+        {
+            int x = random.nextInt(image.width);
+            while (x < image.width)
+            {
+                const int length = 1 + random.nextInt(6);
+                const float level = 0.02f + 0.08f * random.nextFloat();
+
+                for (int i = x; i < juce::jmin(image.width, x + length); ++i)
+                    image.amplitude[(size_t)(i * image.numRows + row)] = level;
+
+                x += length + 1 + random.nextInt(12);
+            }
+        }
+
+        image.findRuns();
+    }
+
+    static void render(CanvasProcessor::PreparedImage&& image, int blockSize, juce::AudioBuffer<float>& output)
+    {
+        CanvasProcessor processor;
+        processor.prepareToPlay(sampleRate, blockSize);
+        processor.setSweepDuration(sweepSeconds);
+        processor.installImage(image);
+        processor.setActive(true);
+
+        output.setSize(2, numSamples);
+        juce::AudioBuffer<float> block(2, blockSize);
+
+        for (int start = 0; start < numSamples; start += blockSize)
+        {
+            const int num = juce::jmin(blockSize, numSamples - start);
+            block.setSize(2, num, false, false, true);
+            processor.processBlock(block);
+
+            for (int ch = 0; ch < 2; ++ch)
+                output.copyFrom(ch, start, block, ch, 0, num);
+        }
+    }
+
+    // Every row updated at every control point and tested at every sample, as before runs were indexed
+    static void renderDense(const CanvasProcessor::PreparedImage& image, juce::AudioBuffer<float>& output)
+    {
+        struct Row { float frequency, phase = 0.0f, amplitude = 0.0f, targetAmplitude = 0.0f, amplitudeStep = 0.0f, pan = 0.5f; };
+        std::vector<Row> rows((size_t)image.numRows);
+
+        const float logMin = std::log(20.0f);
+        const float logMax = std::log(20000.0f);
+        for (int row = 0; row < image.numRows; ++row)
+        {
+            const float normalisedY = 1.0f - (float)(row * image.rowStep) / (float)image.sourceHeight;
+            rows[(size_t)row].frequency = std::exp(logMin + normalisedY * (logMax - logMin));
+        }
+
+        const float rate = (float)sampleRate;
+        const double sweepIncrement = 1.0 / (sweepSeconds * rate);
+        double playheadPos = 0.0;
+
+        output.setSize(2, numSamples);
+        output.clear();
+
+        for (int start = 0; start < numSamples; start += controlInterval)
+        {
+            const double position = playheadPos + controlInterval * sweepIncrement;
+            const double column = (position - std::floor(position)) * image.width;
+            const int column0 = juce::jlimit(0, image.width - 1, (int)column);
+            const float fraction = juce::jlimit(0.0f, 1.0f, (float)(column - column0));
+            const int column1 = (column0 + 1) % image.width;
+
+            for (int row = 0; row < image.numRows; ++row)
+            {
+                auto& r = rows[(size_t)row];
+                float amplitude = image.getAmplitudeColumn(column0)[row] * (1.0f - fraction);
+                amplitude += image.getAmplitudeColumn(column1)[row] * fraction;
+                float pan = image.getPanColumn(column0)[row] * (1.0f - fraction);
+                pan += image.getPanColumn(column1)[row] * fraction;
+
+                r.amplitude = r.targetAmplitude;
+                r.targetAmplitude = amplitude;
+                r.amplitudeStep = (r.targetAmplitude - r.amplitude) * (1.0f / controlInterval);
+                r.pan = pan;
+            }
+
+            const int num = juce::jmin(controlInterval, numSamples - start);
+            for (int i = start; i < start + num; ++i)
+            {
+                float left = 0.0f, right = 0.0f;
+
+                for (auto& r : rows)
+                {
+                    if (r.targetAmplitude > 0.0001f || r.amplitude > 0.0001f)
+                    {
+                        r.amplitude += r.amplitudeStep;
+                        const float s = std::sin(r.phase * juce::MathConstants<float>::twoPi) * r.amplitude;
+                        left += s * (1.0f - r.pan);
+                        right += s * r.pan;
+
+                        r.phase += r.frequency / rate;
+                        if (r.phase >= 1.0f)
+                            r.phase -= 1.0f;
+                    }
+                }
+
+                output.setSample(0, i, left);
+                output.setSample(1, i, right);
+            }
+
+            playheadPos += num * sweepIncrement;
+            if (playheadPos >= 1.0)
+                playheadPos -= std::floor(playheadPos);
+        }
+    }
+
+    static float maxDifference(const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b, int& where)
+    {
+        float worst = 0.0f;
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float difference = std::abs(a.getSample(ch, i) - b.getSample(ch, i));
+                if (difference > worst)
+                {
+                    worst = difference;
+                    where = i;
+                }
+            }
+        }
+        return worst;
+    }
+
+    static bool testBlockSizeIndependence()
+    {
+        DBG("Testing block size independence...");
+
+        juce::AudioBuffer<float> reference;
+        {
+            CanvasProcessor::PreparedImage image;
+            makeSparseImage(image);
+            render(std::move(image), 64, reference);
+        }
+
+        if (reference.getMagnitude(0, 0, numSamples) <= 0.0f)
+        {
+            DBG("FAIL: Test image rendered silence");
+            return false;
+        }
+
+        for (const int blockSize : { 512, 37 })
+        {
+            CanvasProcessor::PreparedImage image;
+            makeSparseImage(image);
+
+            juce::AudioBuffer<float> output;
+            render(std::move(image), blockSize, output);
+
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    if (output.getSample(ch, i) != reference.getSample(ch, i))
+                    {
+                        DBG("FAIL: Block size " << blockSize << " differs from 64 at channel " << ch << ", sample " << i
+                            << ": " << output.getSample(ch, i) << " vs " << reference.getSample(ch, i));
+                        return false;
+                    }
+                }
+            }
+        }
+
+        DBG("✓ Block size test passed");
+        return true;
+    }
+
+    static bool testMatchesDensePath()
+    {
+        DBG("Testing sparse against dense rendering...");
+
+        CanvasProcessor::PreparedImage image;
+        makeSparseImage(image);
+
+        juce::AudioBuffer<float> dense;
+        renderDense(image, dense);
+
+        juce::AudioBuffer<float> sparse;
+        render(std::move(image), 512, sparse);
+
+        int where = 0;
+        const float difference = maxDifference(sparse, dense, where);
+        if (difference > 1.0e-6f)
+        {
+            DBG("FAIL: Sparse render differs from dense by " << difference << " at sample " << where);
+            return false;
+        }
+
+        DBG("✓ Dense match test passed");
+        return true;
+    }
+
+    static bool testUnpaintedRowsFallSilent()
+    {
+        DBG("Testing unpainted rows fall silent...");
+
+        // Painted in the first quarter only: once the playhead is past it every row must have dropped
+        CanvasProcessor::PreparedImage image;
+        image.width = 16;
+        image.numRows = 32;
+        image.sourceHeight = 32;
+        image.amplitude.assign((size_t)(image.width * image.numRows), 0.0f);
+        image.pan.assign((size_t)(image.width * image.numRows), 0.5f);
+
+        for (int x = 0; x < 4; ++x)
+            for (int row = x; row < image.numRows; row += 4)
+                image.amplitude[(size_t)(x * image.numRows + row)] = 0.25f;
+
+        image.findRuns();
+
+        juce::AudioBuffer<float> output;
+        render(std::move(image), 512, output);
+
+        // Columns 0-3 sound; from column 5 on, once the last ramp has run out, nothing may
+        const int samplesPerColumn = (int)(sweepSeconds * sampleRate) / 16;
+        if (output.getMagnitude(0, 0, 3 * samplesPerColumn) <= 0.0f)
+        {
+            DBG("FAIL: Painted columns rendered silence");
+            return false;
+        }
+
+        const int silentFrom = 5 * samplesPerColumn + 2 * controlInterval;
+        const int silentTo = 14 * samplesPerColumn;   // column 15 crossfades into column 0
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            if (output.getMagnitude(ch, silentFrom, silentTo - silentFrom) != 0.0f)
+            {
+                DBG("FAIL: Rows still sounding after the painted columns, channel " << ch);
+                return false;
+            }
+        }
+
+        // The second sweep brings them back
+        const int sweepLength = (int)(sweepSeconds * sampleRate);
+        if (output.getMagnitude(0, sweepLength + samplesPerColumn, 2 * samplesPerColumn) <= 0.0f)
+        {
+            DBG("FAIL: Rows didn't come back on the next sweep");
+            return false;
+        }
+
+        DBG("✓ Unpainted rows test passed");
+        return true;
+    }
+};
+
+// Function to run tests (can be called from main application for validation)
+bool testCanvasProcessor()
+{
+    return CanvasProcessorTest::runBasicTests();
+}
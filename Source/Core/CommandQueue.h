@@ -1,43 +1,229 @@
-#pragma once
-#include "Commands.h"
-
-template <size_t Capacity = 64>
-class CommandQueue
-{
-public:
-    CommandQueue() = default;
-
-    bool push(const Command& c)
-    {
-        const auto nextWrite = (writeIndex + 1) % Capacity;
-        if (nextWrite == readIndex)
-            return false; // full
-
-        buffer[writeIndex] = c;
-        writeIndex = nextWrite;
-        return true;
-    }
-
-    bool pop(Command& out)
-    {
-        if (readIndex == writeIndex)
-            return false; // empty
-
-        out = buffer[readIndex];
-        readIndex = (readIndex + 1) % Capacity;
-        return true;
-    }
-
-    void clear()
-    {
-        readIndex = writeIndex = 0;
-    }
-
-    bool isEmpty() const noexcept { return readIndex == writeIndex; }
-    bool isFull()  const noexcept { return ((writeIndex + 1) % Capacity) == readIndex; }
-
-private:
-    std::array<Command, Capacity> buffer{};
-    std::atomic<size_t> writeIndex{ 0 };
-    std::atomic<size_t> readIndex{ 0 };
-};
+#pragma once
+#include "Commands.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+//==============================================================================
+// Single-producer / single-consumer command ring.
+//
+// The consumer takes everything that is ready in one batch - at most two
+// contiguous runs - and hands the slots back with a single index store, so a
+// block costs two atomic operations no matter how many commands it drains.
+//
+// Once three quarters of the ring are waiting, the producer stages commands
+// locally instead and the last quarter stays free as headroom. A staged
+// "latest value wins" command (pitch, volume, playhead...) drops an earlier
+// staged one for the same target and joins the back, so what goes out is
+// still in push order. Staged commands go out as soon as the ring drains. A command is only dropped when the staging area is full too.
+template <size_t Capacity = 256>
+class CommandQueue
+{
+    static_assert(Capacity >= 8 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    struct Stats
+    {
+        size_t highWaterMark = 0;   // most commands ever waiting in the ring
+        size_t overflowCount = 0;   // commands dropped
+        size_t coalescedCount = 0;  // commands merged into a newer one
+        size_t stagedCount = 0;     // commands waiting on the producer side
+    };
+
+    // Everything the consumer may read, oldest first
+    struct ReadBatch
+    {
+        const Command* first = nullptr;
+        size_t         firstSize = 0;
+        const Command* second = nullptr;
+        size_t         secondSize = 0;
+
+        size_t size() const noexcept { return firstSize + secondSize; }
+        const Command& operator[](size_t i) const noexcept { return i < firstSize ? first[i] : second[i - firstSize]; }
+    };
+
+    CommandQueue() = default;
+
+    //==============================================================================
+    // Producer
+
+    // False only when the command had to be dropped
+    bool push(const Command& c)
+    {
+        flushStaged();
+
+        if (numStaged == 0 && getNumReady() < coalesceThreshold)
+        {
+            write(c);
+            return true;
+        }
+
+        return stage(c);
+    }
+
+    // Moves staged commands into the ring as far as space allows.
+    // Producers call this from a timer so staged commands don't wait for the next push.
+    void flushStaged()
+    {
+        if (numStaged == 0)
+            return;
+
+        const size_t ready = getNumReady();
+        const size_t space = ready < coalesceThreshold ? coalesceThreshold - ready : 0;
+        const size_t toWrite = juce::jmin(space, numStaged);
+
+        for (size_t i = 0; i < toWrite; ++i)
+            write(staged[i]);
+
+        std::move(staged.begin() + (std::ptrdiff_t)toWrite, staged.begin() + (std::ptrdiff_t)numStaged, staged.begin());
+        numStaged -= toWrite;
+        stagedCount.store(numStaged, std::memory_order_relaxed);
+    }
+
+    //==============================================================================
+    // Consumer
+
+    ReadBatch beginRead() const noexcept
+    {
+        const size_t r = readPos.load(std::memory_order_relaxed);
+        const size_t ready = writePos.load(std::memory_order_acquire) - r;
+        const size_t start = r & mask;
+
+        ReadBatch batch;
+        batch.first = buffer.data() + start;
+        batch.firstSize = juce::jmin(ready, Capacity - start);
+        batch.second = buffer.data();
+        batch.secondSize = ready - batch.firstSize;
+        return batch;
+    }
+
+    void endRead(size_t numConsumed) noexcept
+    {
+        readPos.store(readPos.load(std::memory_order_relaxed) + numConsumed, std::memory_order_release);
+    }
+
+    bool pop(Command& out)
+    {
+        const auto batch = beginRead();
+        if (batch.size() == 0)
+            return false; // empty
+
+        out = batch[0];
+        endRead(1);
+        return true;
+    }
+
+    void clear()
+    {
+        readPos.store(writePos.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    //==============================================================================
+    size_t getNumReady() const noexcept
+    {
+        return writePos.load(std::memory_order_acquire) - readPos.load(std::memory_order_acquire);
+    }
+
+    bool isEmpty() const noexcept { return getNumReady() == 0; }
+    bool isFull()  const noexcept { return getNumReady() == Capacity; }
+
+    Stats getStats() const noexcept
+    {
+        Stats s;
+        s.highWaterMark = highWaterMark.load(std::memory_order_relaxed);
+        s.overflowCount = overflowCount.load(std::memory_order_relaxed);
+        s.coalescedCount = coalescedCount.load(std::memory_order_relaxed);
+        s.stagedCount = stagedCount.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    // Commands where only the newest value matters, keyed by command and target
+    static bool isCoalescable(const Command& c) noexcept
+    {
+        if (c.isForgeCommand())
+        {
+            switch (c.getForgeCommandID())
+            {
+            case ForgeCommandID::SetPitch:
+            case ForgeCommandID::SetSpeed:
+            case ForgeCommandID::SetVolume:
+            case ForgeCommandID::SetDrive:
+            case ForgeCommandID::SetCrush:
+            case ForgeCommandID::SetInterpolation:
+            case ForgeCommandID::SetStretchMode:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        switch (c.getPaintCommandID())
+        {
+        case PaintCommandID::SetPlayheadPosition:
+        case PaintCommandID::SetMasterGain:
+        case PaintCommandID::SetFrequencyRange:
+        case PaintCommandID::SetCanvasRegion:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+private:
+    static constexpr size_t mask = Capacity - 1;
+    static constexpr size_t coalesceThreshold = Capacity - Capacity / 4;
+    static constexpr size_t stagingCapacity = Capacity / 4;
+
+    void write(const Command& c)
+    {
+        const size_t w = writePos.load(std::memory_order_relaxed);
+        buffer[w & mask] = c;
+        writePos.store(w + 1, std::memory_order_release);
+
+        const size_t used = w + 1 - readPos.load(std::memory_order_acquire);
+        if (used > highWaterMark.load(std::memory_order_relaxed))
+            highWaterMark.store(used, std::memory_order_relaxed);
+    }
+
+    bool stage(const Command& c)
+    {
+        if (isCoalescable(c))
+        {
+            for (size_t i = 0; i < numStaged; ++i)
+            {
+                if (staged[i].commandId == c.commandId && staged[i].intParam == c.intParam)
+                {
+                    // Not in place: commands staged after the old value must still go out before the new one
+                    std::move(staged.begin() + (std::ptrdiff_t)i + 1, staged.begin() + (std::ptrdiff_t)numStaged,
+                              staged.begin() + (std::ptrdiff_t)i);
+                    staged[numStaged - 1] = c;
+                    coalescedCount.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+        }
+
+        if (numStaged == stagingCapacity)
+        {
+            overflowCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        staged[numStaged++] = c;
+        stagedCount.store(numStaged, std::memory_order_relaxed);
+        return true;
+    }
+
+    std::array<Command, Capacity> buffer{};
+    alignas(64) std::atomic<size_t> writePos{ 0 };   // producer and consumer indices on
+    alignas(64) std::atomic<size_t> readPos{ 0 };    // separate cache lines
+
+    // Producer-only staging
+    std::array<Command, stagingCapacity> staged{};
+    size_t numStaged = 0;
+
+    std::atomic<size_t> highWaterMark{ 0 };
+    std::atomic<size_t> overflowCount{ 0 };
+    std::atomic<size_t> coalescedCount{ 0 };
+    std::atomic<size_t> stagedCount{ 0 };
+};
@@ -0,0 +1,221 @@
+#include "MpscCommandQueue.h"
+#include <JuceHeader.h>
+#include <thread>
+#include <vector>
+
+/**
+ * Command throughput with several producer threads and one consumer
+ * MpscCommandQueue against juce::AbstractFifo, which needs a lock once
+ * there is more than one producer
+ */
+class CommandQueueBenchmark
+{
+public:
+    static bool runBenchmarks()
+    {
+        DBG("=== Command Queue Benchmarks ===");
+
+        for (const int numProducers : { 1, 2, 4, 8 })
+        {
+            const double mpsc = benchmarkMpsc(numProducers);
+            const double fifo = benchmarkAbstractFifo(numProducers);
+
+            if (mpsc <= 0.0 || fifo <= 0.0)
+                return false;
+
+            DBG("  " << numProducers << " producer(s): MPSC " << juce::String(mpsc / 1.0e6, 2)
+                << " M/s, locked AbstractFifo " << juce::String(fifo / 1.0e6, 2) << " M/s ("
+                << juce::String(mpsc / fifo, 2) << "x)");
+        }
+
+        if (!testFairness())
+            return false;
+
+        DBG("=== Command queue benchmarks complete ===");
+        return true;
+    }
+
+private:
+    static constexpr int commandsPerProducer = 200000;
+    static constexpr size_t queueSize = 1024;
+
+    // Commands per second through the lock-free queue, -1 on lost or reordered commands
+    static double benchmarkMpsc(int numProducers)
+    {
+        MpscCommandQueue<queueSize, 8> queue;
+        std::vector<std::thread> producers;
+        std::atomic<bool> go{ false };
+
+        for (int p = 0; p < numProducers; ++p)
+        {
+            const int id = queue.registerProducer();
+            producers.emplace_back([&queue, &go, id]
+            {
+                while (!go.load())
+                    std::this_thread::yield();
+
+                for (int i = 0; i < commandsPerProducer;)
+                {
+                    if (queue.push(id, Command(ForgeCommandID::SetVolume, id, (float)i)))
+                        ++i;
+                    else
+                        std::this_thread::yield();
+                }
+            });
+        }
+
+        std::vector<int> lastSeen((size_t)numProducers, -1);
+        const int total = numProducers * commandsPerProducer;
+        int received = 0;
+        bool inOrder = true;
+
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+        go.store(true);
+
+        Command cmd;
+        while (received < total)
+        {
+            if (!queue.pop(cmd))
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            // Each producer's commands must arrive in the order it sent them
+            const int value = (int)cmd.value.floatParam;
+            inOrder = inOrder && value == lastSeen[(size_t)cmd.intParam] + 1;
+            lastSeen[(size_t)cmd.intParam] = value;
+            ++received;
+        }
+
+        const double seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+
+        for (auto& t : producers)
+            t.join();
+
+        if (!inOrder)
+        {
+            DBG("FAIL: MPSC queue reordered commands from one producer");
+            return -1.0;
+        }
+
+        return total / seconds;
+    }
+
+    // Commands per second through an AbstractFifo, producers serialised by a spin lock
+    static double benchmarkAbstractFifo(int numProducers)
+    {
+        juce::AbstractFifo fifo((int)queueSize);
+        std::vector<Command> storage(queueSize);
+        juce::SpinLock writeLock;
+        std::vector<std::thread> producers;
+        std::atomic<bool> go{ false };
+
+        for (int p = 0; p < numProducers; ++p)
+        {
+            producers.emplace_back([&, p]
+            {
+                while (!go.load())
+                    std::this_thread::yield();
+
+                for (int i = 0; i < commandsPerProducer;)
+                {
+                    bool written = false;
+                    {
+                        const juce::SpinLock::ScopedLockType lock(writeLock);
+                        int start1, size1, start2, size2;
+                        fifo.prepareToWrite(1, start1, size1, start2, size2);
+                        if (size1 > 0)
+                        {
+                            storage[(size_t)start1] = Command(ForgeCommandID::SetVolume, p, (float)i);
+                            fifo.finishedWrite(1);
+                            written = true;
+                        }
+                    }
+
+                    if (written)
+                        ++i;
+                    else
+                        std::this_thread::yield();
+                }
+            });
+        }
+
+        std::vector<int> lastSeen((size_t)numProducers, -1);
+        const int total = numProducers * commandsPerProducer;
+        int received = 0;
+        bool inOrder = true;
+
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+        go.store(true);
+
+        while (received < total)
+        {
+            int start1, size1, start2, size2;
+            fifo.prepareToRead(fifo.getNumReady(), start1, size1, start2, size2);
+
+            if (size1 + size2 == 0)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            // Same per-command work as the MPSC consumer
+            for (int i = 0; i < size1 + size2; ++i)
+            {
+                const Command cmd = storage[(size_t)(i < size1 ? start1 + i : start2 + i - size1)];
+                const int value = (int)cmd.value.floatParam;
+                inOrder = inOrder && value == lastSeen[(size_t)cmd.intParam] + 1;
+                lastSeen[(size_t)cmd.intParam] = value;
+            }
+
+            received += size1 + size2;
+            fifo.finishedRead(size1 + size2);
+        }
+
+        const double seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+
+        for (auto& t : producers)
+            t.join();
+
+        if (!inOrder)
+        {
+            DBG("FAIL: AbstractFifo reordered commands from one producer");
+            return -1.0;
+        }
+
+        return total / seconds;
+    }
+
+    // A flooding producer must not lock out a second one
+    static bool testFairness()
+    {
+        MpscCommandQueue<queueSize, 8> queue;
+        const int flooder = queue.registerProducer();
+        const int gui = queue.registerProducer();
+
+        for (size_t i = 0; i < queueSize; ++i)
+            queue.push(flooder, Command(ForgeCommandID::SetPitch, 0, 0.0f));
+
+        if (!queue.push(gui, Command(ForgeCommandID::StartPlayback, 0)))
+        {
+            DBG("FAIL: Flooding producer starved the others");
+            return false;
+        }
+
+        if (queue.getRejectedCount(flooder) != queueSize - (size_t)decltype(queue)::quotaPerProducer)
+        {
+            DBG("FAIL: Flooding producer exceeded its share");
+            return false;
+        }
+
+        DBG("  fairness: flooder capped at " << decltype(queue)::quotaPerProducer << " in flight");
+        return true;
+    }
+};
+
+// Function to run benchmarks (can be called from main application during development)
+bool benchmarkCommandQueues()
+{
+    return CommandQueueBenchmark::runBenchmarks();
+}
@@ -0,0 +1,173 @@
+#include "CommandQueue.h"
+#include <JuceHeader.h>
+#include <vector>
+
+/**
+ * Ordering tests for CommandQueue's staging area.
+ * The audio thread applies commands in timestamp order, so coalescing a
+ * staged command must never let it overtake one that was pushed after it.
+ */
+class CommandQueueTest
+{
+public:
+    static bool runBasicTests()
+    {
+        DBG("=== CommandQueue Ordering Tests ===");
+
+        // Test 1: SetPitch, LoadSample, SetPitch for one slot drains as LoadSample, SetPitch
+        if (!testCoalescedGoesToBack())
+            return false;
+
+        // Test 2: A longer interleaving keeps push order and ascending timestamps
+        if (!testInterleavedOrder())
+            return false;
+
+        DBG("=== All CommandQueue tests passed! ===");
+        return true;
+    }
+
+private:
+    using Queue = CommandQueue<64>;
+    static constexpr int filler = 48;   // the queue's coalescing threshold: later pushes are staged
+
+    // Fills the ring up to where staging starts, with commands for a slot the tests don't use
+    static void fillRing(Queue& queue, juce::int64& time)
+    {
+        for (int i = 0; i < filler; ++i)
+        {
+            Command c(ForgeCommandID::SetVolume, 7, (float)i);
+            c.timestamp = time++;
+            queue.push(c);
+        }
+    }
+
+    static void push(Queue& queue, Command c, juce::int64& time)
+    {
+        c.timestamp = time++;
+        queue.push(c);
+    }
+
+    // Everything, ring first and then whatever was staged
+    static std::vector<Command> drain(Queue& queue)
+    {
+        std::vector<Command> out;
+        Command c;
+
+        while (!queue.isEmpty() || queue.getStats().stagedCount > 0)
+        {
+            while (queue.pop(c))
+                out.push_back(c);
+            queue.flushStaged();
+        }
+        return out;
+    }
+
+    static bool checkTimestamps(const std::vector<Command>& drained)
+    {
+        for (size_t i = 1; i < drained.size(); ++i)
+        {
+            if (drained[i].timestamp < drained[i - 1].timestamp)
+            {
+                DBG("FAIL: Command " << (int)i << " has timestamp " << drained[i].timestamp
+                    << ", before " << drained[i - 1].timestamp);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static bool testCoalescedGoesToBack()
+    {
+        DBG("Testing a coalesced command moves behind later ones...");
+
+        Queue queue;
+        juce::int64 time = 0;
+        fillRing(queue, time);
+
+        push(queue, Command(ForgeCommandID::SetPitch, 0, 1.0f), time);
+        push(queue, Command(ForgeCommandID::LoadSample, 0), time);
+        push(queue, Command(ForgeCommandID::SetPitch, 0, 2.0f), time);
+
+        if (queue.getStats().coalescedCount != 1)
+        {
+            DBG("FAIL: Expected one coalesced command, got " << (int)queue.getStats().coalescedCount);
+            return false;
+        }
+
+        const auto drained = drain(queue);
+        if (drained.size() != (size_t)filler + 2)
+        {
+            DBG("FAIL: Drained " << (int)drained.size() << " commands, expected " << filler + 2);
+            return false;
+        }
+
+        const auto& load = drained[(size_t)filler];
+        const auto& pitch = drained[(size_t)filler + 1];
+        if (load.getForgeCommandID() != ForgeCommandID::LoadSample
+            || pitch.getForgeCommandID() != ForgeCommandID::SetPitch || pitch.value.floatParam != 2.0f)
+        {
+            DBG("FAIL: Expected LoadSample then SetPitch(2), got commands " << load.commandId << ", "
+                << pitch.commandId << " (" << pitch.value.floatParam << ")");
+            return false;
+        }
+
+        if (!checkTimestamps(drained))
+            return false;
+
+        DBG("✓ Coalesced order test passed");
+        return true;
+    }
+
+    static bool testInterleavedOrder()
+    {
+        DBG("Testing interleaved commands for one slot...");
+
+        Queue queue;
+        juce::int64 time = 0;
+        fillRing(queue, time);
+
+        // Pitch and volume move while a sample loads between them
+        push(queue, Command(ForgeCommandID::SetPitch, 0, 1.0f), time);
+        push(queue, Command(ForgeCommandID::SetVolume, 0, 0.5f), time);
+        push(queue, Command(ForgeCommandID::SetPitch, 0, 2.0f), time);
+        push(queue, Command(ForgeCommandID::LoadSample, 0), time);
+        push(queue, Command(ForgeCommandID::SetVolume, 0, 0.25f), time);
+        push(queue, Command(ForgeCommandID::SetPitch, 0, 3.0f), time);
+
+        const auto drained = drain(queue);
+        const std::vector<std::pair<ForgeCommandID, float>> expected = {
+            { ForgeCommandID::LoadSample, 0.0f },
+            { ForgeCommandID::SetVolume, 0.25f },
+            { ForgeCommandID::SetPitch, 3.0f }
+        };
+
+        if (drained.size() != (size_t)filler + expected.size())
+        {
+            DBG("FAIL: Drained " << (int)drained.size() << " commands, expected " << filler + (int)expected.size());
+            return false;
+        }
+
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            const auto& c = drained[(size_t)filler + i];
+            if (c.getForgeCommandID() != expected[i].first || c.value.floatParam != expected[i].second)
+            {
+                DBG("FAIL: Staged command " << (int)i << " is " << c.commandId << " (" << c.value.floatParam << "), expected "
+                    << (int)expected[i].first << " (" << expected[i].second << ")");
+                return false;
+            }
+        }
+
+        if (!checkTimestamps(drained))
+            return false;
+
+        DBG("✓ Interleaved order test passed");
+        return true;
+    }
+};
+
+// Function to run tests (can be called from main application for validation)
+bool testCommandQueue()
+{
+    return CommandQueueTest::runBasicTests();
+}
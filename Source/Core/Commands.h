@@ -1,96 +1,141 @@
-#pragma once
-// ──────────────────────────────────────────────────────────────────────────────
-// JUCE defines a legacy   #define CommandID int
-// Undefine it before we declare our own enum:
-#ifdef CommandID
-#undef CommandID
-#endif
-// ──────────────────────────────────────────────────────────────────────────────
-#include <JuceHeader.h>
-
-// Unique, project-scoped identifiers -----------------------------------------
-enum class ForgeCommandID
-{
-    // Test
-    Test = 0,
-
-    // Forge commands
-    LoadSample = 10,
-    StartPlayback,
-    StopPlayback,
-    SetPitch,
-    SetSpeed,
-    SetSyncMode,
-    SetVolume,
-    SetDrive,
-    SetCrush,
-
-    // Canvas commands (legacy - being replaced by PaintCommandID)
-    LoadCanvasImage = 50,
-    SetCanvasPlayhead,
-    SetCanvasActive,
-    SetProcessingMode,
-    SetCanvasFreqRange
-};
-
-// New Paint Engine commands
-enum class PaintCommandID
-{
-    BeginStroke = 200,
-    UpdateStroke,
-    EndStroke,
-    ClearCanvas,
-    ClearRegion,
-    SetPlayheadPosition,
-    SetCanvasRegion,
-    SetPaintActive,
-    SetMasterGain,
-    SetFrequencyRange
-};
-
-// FIFO message object ---------------------------------------------------------
-struct Command
-{
-    // Command type - can be either ForgeCommandID or PaintCommandID
-    int commandId = static_cast<int>(ForgeCommandID::Test);
-    
-    // Basic parameters
-    int            intParam = -1;        // slot / index / mode
-    float          floatParam = 0.0f;    // numeric value
-    double         doubleParam = 0.0;    // double precision value
-    bool           boolParam = false;    // flag / toggle
-    juce::String   stringParam;          // path / text
-    
-    // Extended parameters for PaintEngine
-    float          x = 0.0f;             // Canvas X position
-    float          y = 0.0f;             // Canvas Y position  
-    float          pressure = 1.0f;      // Brush pressure
-    juce::Colour   color;                // Brush color
-
-    // Constructors for Forge commands
-    Command() = default;
-    explicit Command(ForgeCommandID c) : commandId(static_cast<int>(c)) {}
-    Command(ForgeCommandID c, int s) : commandId(static_cast<int>(c)), intParam(s) {}
-    Command(ForgeCommandID c, int s, float v) : commandId(static_cast<int>(c)), intParam(s), floatParam(v) {}
-    Command(ForgeCommandID c, int s, bool  b) : commandId(static_cast<int>(c)), intParam(s), boolParam(b) {}
-    Command(ForgeCommandID c, int s, const juce::String& p) : commandId(static_cast<int>(c)), intParam(s), stringParam(p) {}
-    Command(ForgeCommandID c, float v) : commandId(static_cast<int>(c)), floatParam(v) {}
-    Command(ForgeCommandID c, bool b) : commandId(static_cast<int>(c)), boolParam(b) {}
-    Command(ForgeCommandID c, const juce::String& p) : commandId(static_cast<int>(c)), stringParam(p) {}
-    
-    // Constructors for Paint commands
-    explicit Command(PaintCommandID c) : commandId(static_cast<int>(c)) {}
-    Command(PaintCommandID c, float x_, float y_, float pressure_ = 1.0f, juce::Colour color_ = juce::Colours::white)
-        : commandId(static_cast<int>(c)), x(x_), y(y_), pressure(pressure_), color(color_) {}
-    Command(PaintCommandID c, float x_, float y_, float width, float height)
-        : commandId(static_cast<int>(c)), x(x_), y(y_), floatParam(width), doubleParam(height) {}
-    Command(PaintCommandID c, float value) : commandId(static_cast<int>(c)), floatParam(value) {}
-    Command(PaintCommandID c, bool value) : commandId(static_cast<int>(c)), boolParam(value) {}
-    Command(PaintCommandID c, float min, float max) : commandId(static_cast<int>(c)), floatParam(min), doubleParam(max) {}
-    
-    // Helper methods to check command type
-    bool isForgeCommand() const { return commandId < 200; }
-    bool isPaintCommand() const { return commandId >= 200; }
-    ForgeCommandID getForgeCommandID() const { return static_cast<ForgeCommandID>(commandId); }
-    PaintCommandID getPaintCommandID() const { return static_cast<PaintCommandID>(commandId); }
-};
\ No newline at end of file
+#pragma once
+// ──────────────────────────────────────────────────────────────────────────────
+// JUCE defines a legacy   #define CommandID int
+// Undefine it before we declare our own enum:
+#ifdef CommandID
+#undef CommandID
+#endif
+// ──────────────────────────────────────────────────────────────────────────────
+#include <JuceHeader.h>
+#include <array>
+#include <type_traits>
+#include "PayloadPool.h"
+
+// Unique, project-scoped identifiers -----------------------------------------
+enum class ForgeCommandID
+{
+    // Test
+    Test = 0,
+
+    // Forge commands
+    LoadSample = 10,    // intParam = slot, payload = ForgeProcessor::PreparedSample
+    StartPlayback,
+    StopPlayback,
+    SetPitch,
+    SetSpeed,
+    SetSyncMode,
+    SetVolume,
+    SetDrive,
+    SetCrush,
+    SetInterpolation,   // intParam = slot, floatParam = ForgeVoice::Interpolation index
+    SetStretchMode,     // intParam = slot, floatParam = ForgeVoice::StretchMode index
+    SpliceSample,       // intParam = slot, payload = ForgeProcessor::PreparedSplice
+
+    // Canvas commands (legacy - being replaced by PaintCommandID)
+    LoadCanvasImage = 50,   // payload = CanvasProcessor::PreparedImage
+    SetCanvasPlayhead,
+    SetCanvasActive,
+    SetProcessingMode,
+    SetCanvasFreqRange,
+    SetCanvasSweepDuration  // floatParam = seconds per pass, 0 = hold
+};
+
+// New Paint Engine commands
+enum class PaintCommandID
+{
+    BeginStroke = 200,
+    UpdateStroke,
+    EndStroke,
+    ClearCanvas,
+    ClearRegion,
+    SetPlayheadPosition,
+    SetCanvasRegion,
+    SetPaintActive,
+    SetMasterGain,
+    SetFrequencyRange,
+    StrokeSegment           // payload = StrokeSegment
+};
+
+// Brush points gathered by the editor between frames. Sent as one command so
+// the engine updates the canvas once per segment rather than once per point.
+struct StrokeSegment
+{
+    static constexpr int maxPoints = 32;
+
+    std::array<float, maxPoints> x{};
+    std::array<float, maxPoints> y{};
+    std::array<float, maxPoints> pressure{};
+    int numPoints = 0;
+
+    bool isEmpty() const noexcept { return numPoints == 0; }
+    bool isFull()  const noexcept { return numPoints == maxPoints; }
+    void clear() noexcept { numPoints = 0; }
+
+    void addPoint(float x_, float y_, float pressure_) noexcept
+    {
+        jassert(!isFull());
+        x[(size_t)numPoints] = x_;
+        y[(size_t)numPoints] = y_;
+        pressure[(size_t)numPoints] = pressure_;
+        ++numPoints;
+    }
+};
+
+// FIFO message object ---------------------------------------------------------
+// Trivially copyable and 32 bytes, two to a cache line. Copying one never
+// touches the heap; anything variable-sized (decoded samples, paths) lives in
+// a PayloadPool and travels here as a PayloadHandle.
+struct Command
+{
+    // Payload shapes; commandId says which one is live
+    struct Value  { float floatParam; float floatParam2; bool boolParam; };  // numbers / flag / range
+    struct Stroke { float x, y, pressure; juce::uint32 argb; };              // brush point
+    struct Region { float x, y, width, height; };                            // canvas rectangle
+
+    // When the command was issued, in juce::Time high-resolution ticks.
+    // Stamped by the processor when pushed; 0 applies it at the start of the next block.
+    juce::int64    timestamp = 0;
+
+    // Command type - can be either ForgeCommandID or PaintCommandID
+    juce::int32    commandId = static_cast<juce::int32>(ForgeCommandID::Test);
+    juce::int32    intParam = -1;        // slot / index / mode
+
+    union
+    {
+        Value         value{ 0.0f, 0.0f, false };
+        Stroke        stroke;
+        Region        region;
+        PayloadHandle payload;
+    };
+
+    // Constructors for Forge commands
+    Command() = default;
+    explicit Command(ForgeCommandID c) : commandId(static_cast<int>(c)) {}
+    Command(ForgeCommandID c, int s) : commandId(static_cast<int>(c)), intParam(s) {}
+    Command(ForgeCommandID c, int s, float v) : commandId(static_cast<int>(c)), intParam(s), value{ v, 0.0f, false } {}
+    Command(ForgeCommandID c, int s, bool  b) : commandId(static_cast<int>(c)), intParam(s), value{ 0.0f, 0.0f, b } {}
+    Command(ForgeCommandID c, int s, PayloadHandle h) : commandId(static_cast<int>(c)), intParam(s), payload(h) {}
+    Command(ForgeCommandID c, float v) : commandId(static_cast<int>(c)), value{ v, 0.0f, false } {}
+    Command(ForgeCommandID c, bool b) : commandId(static_cast<int>(c)), value{ 0.0f, 0.0f, b } {}
+
+    // Constructors for Paint commands
+    explicit Command(PaintCommandID c) : commandId(static_cast<int>(c)) {}
+    Command(PaintCommandID c, float x_, float y_, float pressure_ = 1.0f, juce::Colour color_ = juce::Colours::white)
+        : commandId(static_cast<int>(c)), stroke{ x_, y_, pressure_, color_.getARGB() } {}
+    Command(PaintCommandID c, float x_, float y_, float width, float height)
+        : commandId(static_cast<int>(c)), region{ x_, y_, width, height } {}
+    Command(PaintCommandID c, float value_) : commandId(static_cast<int>(c)), value{ value_, 0.0f, false } {}
+    Command(PaintCommandID c, bool value_) : commandId(static_cast<int>(c)), value{ 0.0f, 0.0f, value_ } {}
+    Command(PaintCommandID c, float min, float max) : commandId(static_cast<int>(c)), value{ min, max, false } {}
+    Command(PaintCommandID c, PayloadHandle h) : commandId(static_cast<int>(c)), payload(h) {}
+
+    // Helper methods to check command type
+    bool isForgeCommand() const { return commandId < 200; }
+    bool isPaintCommand() const { return commandId >= 200; }
+    ForgeCommandID getForgeCommandID() const { return static_cast<ForgeCommandID>(commandId); }
+    PaintCommandID getPaintCommandID() const { return static_cast<PaintCommandID>(commandId); }
+    juce::Colour getColour() const { return juce::Colour(stroke.argb); }
+};
+
+static_assert(std::is_trivially_copyable<Command>::value, "Commands are copied through lock-free FIFOs");
+static_assert(sizeof(Command) <= 32, "Keep two commands per cache line");
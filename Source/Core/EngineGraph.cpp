@@ -0,0 +1,394 @@
+// Core/EngineGraph.cpp
+#include "EngineGraph.h"
+#include <thread>
+
+EngineGraph::~EngineGraph()
+{
+    release();
+}
+
+//==============================================================================
+int EngineGraph::addNode(std::unique_ptr<EngineNode> node)
+{
+    jassert(!prepared && numNodes < maxNodes);
+    nodes[(size_t)numNodes].engine = std::move(node);
+    return numNodes++;
+}
+
+void EngineGraph::connect(int sourceNode, int destinationNode)
+{
+    jassert(!prepared);
+    jassert(juce::isPositiveAndBelow(sourceNode, numNodes) && juce::isPositiveAndBelow(destinationNode, numNodes));
+
+    nodes[(size_t)sourceNode].outputs.push_back(destinationNode);
+    nodes[(size_t)destinationNode].inputs.push_back(sourceNode);
+}
+
+void EngineGraph::prepare(double newSampleRate, int numChannels, int maxBlockSize)
+{
+    release();
+    sampleRate = newSampleRate;
+
+    // Kahn's algorithm; anything left over sits on a cycle and would never run
+    std::vector<int> indegree((size_t)numNodes);
+    std::vector<int> ready;
+    sources.clear();
+
+    for (int i = 0; i < numNodes; ++i)
+    {
+        indegree[(size_t)i] = (int)nodes[(size_t)i].inputs.size();
+        if (indegree[(size_t)i] == 0)
+        {
+            sources.push_back(i);
+            ready.push_back(i);
+        }
+    }
+
+    int numSorted = 0;
+    while (!ready.empty())
+    {
+        const int i = ready.back();
+        ready.pop_back();
+        ++numSorted;
+
+        for (const int out : nodes[(size_t)i].outputs)
+            if (--indegree[(size_t)out] == 0)
+                ready.push_back(out);
+    }
+
+    jassert(numSorted == numNodes);   // the graph has a cycle
+    juce::ignoreUnused(numSorted);
+
+    for (int i = 0; i < numNodes; ++i)
+    {
+        auto& node = nodes[(size_t)i];
+        node.engine->prepare(sampleRate, numChannels, maxBlockSize);
+        node.bus.setSize(numChannels, maxBlockSize);
+        node.segmentEnabled = node.enabled.load();
+        node.gain.reset(sampleRate, 0.02);
+        node.gain.setCurrentAndTargetValue(node.segmentEnabled ? node.outputGain.load() : 0.0f);
+        node.silentSamples = alwaysSilent;
+        node.renderTicks = 0;
+    }
+
+    gainRamp.assign((size_t)maxBlockSize, 0.0f);
+    completed.store(numNodes, std::memory_order_relaxed);   // nothing to do until the first segment
+
+    // Workers only pay off when branches can run side by side
+    const int numWorkers = juce::jlimit(0, maxWorkers,
+                                        juce::jmin(juce::SystemStats::getNumCpus() - 1, (int)sources.size() - 1));
+    // Scheduled like the audio thread itself, so a worker is never preempted mid-node
+    const auto realtimeOptions = juce::Thread::RealtimeOptions{}
+                                     .withApproximateAudioProcessingTime(maxBlockSize, sampleRate);
+
+    for (int w = 0; w < numWorkers; ++w)
+    {
+        workers.push_back(std::make_unique<Worker>(*this, w + 1));
+        workers.back()->startRealtimeThread(realtimeOptions);
+    }
+
+    prepared = true;
+}
+
+void EngineGraph::release()
+{
+    for (auto& w : workers)
+    {
+        w->signalThreadShouldExit();
+        w->wakeUp.signal();
+    }
+
+    for (auto& w : workers)
+        w->stopThread(1000);
+
+    workers.clear();
+    prepared = false;
+}
+
+//==============================================================================
+void EngineGraph::setNodeEnabled(int node, bool shouldBeEnabled)
+{
+    jassert(juce::isPositiveAndBelow(node, numNodes));
+    nodes[(size_t)node].enabled.store(shouldBeEnabled, std::memory_order_relaxed);
+}
+
+void EngineGraph::setOutputGain(int node, float gain)
+{
+    jassert(juce::isPositiveAndBelow(node, numNodes));
+    nodes[(size_t)node].outputGain.store(gain, std::memory_order_relaxed);
+}
+
+bool EngineGraph::isNodeEnabled(int node) const
+{
+    jassert(juce::isPositiveAndBelow(node, numNodes));
+    return nodes[(size_t)node].enabled.load(std::memory_order_relaxed);
+}
+
+bool EngineGraph::isNodeAsleep(int node) const
+{
+    jassert(juce::isPositiveAndBelow(node, numNodes));
+    return nodes[(size_t)node].asleep.load(std::memory_order_relaxed);
+}
+
+float EngineGraph::takeNodeCpuLoad(int node, double elapsedSeconds)
+{
+    jassert(juce::isPositiveAndBelow(node, numNodes));
+    auto& n = nodes[(size_t)node];
+    const double seconds = juce::Time::highResolutionTicksToSeconds(n.renderTicks);
+    n.renderTicks = 0;
+    return elapsedSeconds > 0.0 ? (float)(seconds / elapsedSeconds) : 0.0f;
+}
+
+//==============================================================================
+void EngineGraph::process(juce::AudioBuffer<float>& output, const juce::MidiBuffer& midi, int startSample, int numSamples)
+{
+    if (numSamples <= 0)
+        return;
+
+    for (int ch = 0; ch < output.getNumChannels(); ++ch)
+        output.clear(ch, startSample, numSamples);
+
+    if (!prepared || numNodes == 0)
+        return;
+
+    // Only when the host sends a bigger block than it announced
+    const int needed = startSample + numSamples;
+    if (nodes[0].bus.getNumSamples() < needed || nodes[0].bus.getNumChannels() < output.getNumChannels())
+    {
+        for (int i = 0; i < numNodes; ++i)
+            nodes[(size_t)i].bus.setSize(output.getNumChannels(), needed, false, false, true);
+    }
+
+    if ((int)gainRamp.size() < numSamples)
+        gainRamp.resize((size_t)numSamples);
+
+    // Every node of the last segment has completed, so no worker holds a node.
+    // Workers only read the segment after taking a node from a queue.
+    for (auto& q : queues)
+        q.reset();
+
+    for (int i = 0; i < numNodes; ++i)
+    {
+        auto& node = nodes[(size_t)i];
+        node.pendingInputs.store((int)node.inputs.size(), std::memory_order_relaxed);
+        node.segmentEnabled = node.enabled.load(std::memory_order_relaxed);
+    }
+
+    segmentMidi = &midi;
+    segmentStart = startSample;
+    segmentLength = numSamples;
+    completed.store(0, std::memory_order_release);
+
+    // Sleeping sources are finished straight away. The rest are queued in reverse,
+    // so the audio thread starts on the first and workers steal the others.
+    int numRunnable = 0;
+    for (auto it = sources.rbegin(); it != sources.rend(); ++it)
+    {
+        if (shouldSleep(nodes[(size_t)*it], false))
+        {
+            finishNode(*it, 0, false, true);
+        }
+        else
+        {
+            queues[0].push(*it);
+            ++numRunnable;
+        }
+    }
+
+    for (int w = 0; w < juce::jmin((int)workers.size(), numRunnable - 1); ++w)
+        workers[(size_t)w]->wakeUp.signal();
+
+    runUntilDone(0, nullptr);
+    mixSinks(output, startSample, numSamples);
+}
+
+void EngineGraph::runUntilDone(int queueIndex, const juce::Thread* thread)
+{
+    while (completed.load(std::memory_order_acquire) < numNodes)
+    {
+        if (thread != nullptr && thread->threadShouldExit())
+            return;
+
+        int node;
+        if (takeWork(queueIndex, node))
+            runNode(node, queueIndex);
+        else
+            std::this_thread::yield();   // another thread is rendering the last runnable nodes
+    }
+}
+
+bool EngineGraph::takeWork(int queueIndex, int& node) noexcept
+{
+    if (queues[(size_t)queueIndex].popNewest(node))
+        return true;
+
+    const int numQueues = (int)workers.size() + 1;
+    for (int k = 1; k < numQueues; ++k)
+        if (queues[(size_t)((queueIndex + k) % numQueues)].stealOldest(node))
+            return true;
+
+    return false;
+}
+
+void EngineGraph::runNode(int index, int queueIndex)
+{
+    auto& node = nodes[(size_t)index];
+    auto& bus = node.bus;
+
+    bool anyInput = false;
+    for (const int in : node.inputs)
+        anyInput = anyInput || nodes[(size_t)in].producedAudio;
+
+    if (shouldSleep(node, anyInput))
+    {
+        finishNode(index, queueIndex, false, true);
+        return;
+    }
+
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+
+    for (int ch = 0; ch < bus.getNumChannels(); ++ch)
+    {
+        bus.clear(ch, segmentStart, segmentLength);
+
+        for (const int in : node.inputs)
+            if (nodes[(size_t)in].producedAudio)
+                juce::FloatVectorOperations::add(bus.getWritePointer(ch, segmentStart),
+                                                 nodes[(size_t)in].bus.getReadPointer(ch, segmentStart),
+                                                 segmentLength);
+    }
+
+    node.engine->render(bus, *segmentMidi, segmentStart, segmentLength);
+
+    float peak = 0.0f;
+    for (int ch = 0; ch < bus.getNumChannels(); ++ch)
+        peak = juce::jmax(peak, bus.getMagnitude(ch, segmentStart, segmentLength));
+
+    const bool silent = peak < silenceThreshold;
+    node.silentSamples = silent ? juce::jmin(alwaysSilent, node.silentSamples + segmentLength) : 0;
+    node.renderTicks += juce::Time::getHighResolutionTicks() - startTicks;
+
+    finishNode(index, queueIndex, !silent, false);
+}
+
+bool EngineGraph::shouldSleep(const Node& node, bool anyInput) const
+{
+    // Disabled: an output node renders on until its gain has faded out, anything else stops at once
+    if (!node.segmentEnabled
+        && (!node.outputs.empty() || (node.gain.getTargetValue() == 0.0f && !node.gain.isSmoothing())))
+        return true;
+
+    if (anyInput)
+        return false;
+
+    // Still ringing out: keep rendering until the tail has been silent for its full length
+    const int tailSamples = (int)(node.engine->getTailSeconds() * sampleRate);
+    return node.silentSamples > tailSamples
+           && node.engine->isIdle(*segmentMidi, segmentStart, segmentLength);
+}
+
+void EngineGraph::finishNode(int index, int queueIndex, bool producedAudio, bool slept)
+{
+    auto& node = nodes[(size_t)index];
+    node.producedAudio = producedAudio;
+    node.asleep.store(slept, std::memory_order_relaxed);
+
+    for (const int out : node.outputs)
+        if (nodes[(size_t)out].pendingInputs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            queues[(size_t)queueIndex].push(out);
+
+    completed.fetch_add(1, std::memory_order_release);
+}
+
+void EngineGraph::mixSinks(juce::AudioBuffer<float>& output, int startSample, int numSamples)
+{
+    const int numChannels = output.getNumChannels();
+
+    for (int i = 0; i < numNodes; ++i)
+    {
+        auto& node = nodes[(size_t)i];
+        if (!node.outputs.empty())
+            continue;
+
+        node.gain.setTargetValue(node.segmentEnabled ? node.outputGain.load(std::memory_order_relaxed) : 0.0f);
+
+        if (!node.producedAudio)
+        {
+            node.gain.skip(numSamples);
+            continue;
+        }
+
+        if (node.gain.isSmoothing())
+        {
+            for (int s = 0; s < numSamples; ++s)
+                gainRamp[(size_t)s] = node.gain.getNextValue();
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                juce::FloatVectorOperations::addWithMultiply(output.getWritePointer(ch, startSample),
+                                                             node.bus.getReadPointer(ch, startSample),
+                                                             gainRamp.data(), numSamples);
+        }
+        else
+        {
+            const float gain = node.gain.getTargetValue();
+            if (gain == 0.0f)
+                continue;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                juce::FloatVectorOperations::addWithMultiply(output.getWritePointer(ch, startSample),
+                                                             node.bus.getReadPointer(ch, startSample),
+                                                             gain, numSamples);
+        }
+    }
+}
+
+//==============================================================================
+void EngineGraph::WorkQueue::reset() noexcept
+{
+    const juce::SpinLock::ScopedLockType sl(lock);
+    head = tail = 0;
+}
+
+void EngineGraph::WorkQueue::push(int node) noexcept
+{
+    const juce::SpinLock::ScopedLockType sl(lock);
+    jassert(tail < maxNodes);   // each node is queued at most once per segment
+    items[(size_t)tail++] = node;
+}
+
+bool EngineGraph::WorkQueue::popNewest(int& node) noexcept
+{
+    const juce::SpinLock::ScopedLockType sl(lock);
+    if (head == tail)
+        return false;
+
+    node = items[(size_t)--tail];
+    return true;
+}
+
+bool EngineGraph::WorkQueue::stealOldest(int& node) noexcept
+{
+    const juce::SpinLock::ScopedLockType sl(lock);
+    if (head == tail)
+        return false;
+
+    node = items[(size_t)head++];
+    return true;
+}
+
+//==============================================================================
+EngineGraph::Worker::Worker(EngineGraph& owner, int queueIndex)
+    : juce::Thread("Engine graph worker " + juce::String(queueIndex)), graph(owner), queue(queueIndex)
+{
+}
+
+void EngineGraph::Worker::run()
+{
+    const juce::ScopedNoDenormals noDenormals;
+
+    while (!threadShouldExit())
+    {
+        wakeUp.wait(100);
+        graph.runUntilDone(queue, this);
+    }
+}
@@ -0,0 +1,156 @@
+// Core/EngineGraph.h
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "WakeSignal.h"
+
+//==============================================================================
+// One engine or effect in an EngineGraph. Each node renders into its own bus.
+class EngineNode
+{
+public:
+    virtual ~EngineNode() = default;
+
+    virtual void prepare(double sampleRate, int numChannels, int maxBlockSize) = 0;
+
+    // On entry bus holds the sum of this node's inputs over [startSample, startSample + numSamples),
+    // silence for a source. Render the node's output over it in place.
+    virtual void render(juce::AudioBuffer<float>& bus, const juce::MidiBuffer& midi, int startSample, int numSamples) = 0;
+
+    // True when the node would only output silence given silent inputs, so rendering can be skipped
+    virtual bool isIdle(const juce::MidiBuffer& midi, int startSample, int numSamples) const = 0;
+
+    // How long the output may keep ringing after the node goes idle (reverb, delay...)
+    virtual double getTailSeconds() const { return 0.0; }
+};
+
+//==============================================================================
+// A small audio graph for the engines. Nodes feed each other along
+// connections and every node without outgoing connections is summed into the
+// output at its own gain.
+//
+// Each segment, source nodes are queued and whichever thread finishes a
+// node's last input queues that node next. The audio thread and a few workers
+// each keep a queue of runnable nodes. They take their own newest work first
+// and steal the oldest from the others when they run dry, so independent
+// branches render side by side. The audio thread renders too and only waits
+// once nothing is left to start. Idle workers sleep on a WakeSignal, which the
+// audio thread posts without locking.
+//
+// A node goes to sleep, costing nothing, when it is disabled, or when it is
+// idle, none of its inputs produced audio this segment and its own output has
+// been silent for longer than its tail. It wakes the first segment it stops
+// being idle. Silent output is not mixed or passed on. Disabling an output
+// node fades its gain to zero before it sleeps, and enabling it fades back in
+// from zero, so switching engines doesn't click.
+//
+// The topology is fixed once prepare() has been called; enabling nodes and
+// output gains may change at any time from any thread.
+class EngineGraph
+{
+public:
+    static constexpr int maxNodes = 16;
+    static constexpr int maxWorkers = 3;
+
+    EngineGraph() = default;
+    ~EngineGraph();
+
+    // Building, before prepare()
+    int addNode(std::unique_ptr<EngineNode> node);
+    void connect(int sourceNode, int destinationNode);
+
+    // Prepares every node, sizes the buses and starts the workers; not on the audio thread
+    void prepare(double sampleRate, int numChannels, int maxBlockSize);
+    void release();
+
+    // Any thread
+    void setNodeEnabled(int node, bool shouldBeEnabled);
+    void setOutputGain(int node, float gain);
+    bool isNodeEnabled(int node) const;
+    bool isNodeAsleep(int node) const;
+
+    // Audio thread, between process() calls: the node's render time since the last call
+    // as a fraction of elapsedSeconds. Zero while it sleeps.
+    float takeNodeCpuLoad(int node, double elapsedSeconds);
+
+    // Audio thread: replaces [startSample, startSample + numSamples) of output with the graph's output
+    void process(juce::AudioBuffer<float>& output, const juce::MidiBuffer& midi, int startSample, int numSamples);
+
+    int getNumNodes() const { return numNodes; }
+    int getNumWorkers() const { return (int)workers.size(); }
+
+private:
+    struct Node
+    {
+        std::unique_ptr<EngineNode> engine;
+        std::vector<int> inputs, outputs;
+        juce::AudioBuffer<float> bus;
+
+        std::atomic<bool>  enabled{ true };
+        std::atomic<float> outputGain{ 1.0f };
+        juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> gain{ 1.0f };   // audio thread
+        bool segmentEnabled = true;   // enabled as read at the start of the segment, so every thread agrees
+
+        std::atomic<int> pendingInputs{ 0 };
+        bool producedAudio = false;   // written before the node's outputs are released
+        int silentSamples = 0;        // how long the output has been silent
+        juce::int64 renderTicks = 0;
+        std::atomic<bool> asleep{ true };
+    };
+
+    // Runnable nodes for one thread, guarded by a spin lock held for a few instructions
+    struct alignas(64) WorkQueue
+    {
+        juce::SpinLock lock;
+        std::array<int, maxNodes> items{};
+        int head = 0, tail = 0;
+
+        void reset() noexcept;
+        void push(int node) noexcept;
+        bool popNewest(int& node) noexcept;
+        bool stealOldest(int& node) noexcept;
+    };
+
+    class Worker : public juce::Thread
+    {
+    public:
+        Worker(EngineGraph& owner, int queueIndex);
+        void run() override;
+        WakeSignal wakeUp;   // posted by the audio thread, so it must not lock
+
+    private:
+        EngineGraph& graph;
+        const int queue;
+    };
+
+    bool takeWork(int queueIndex, int& node) noexcept;
+    void runUntilDone(int queueIndex, const juce::Thread* thread);
+    bool shouldSleep(const Node& node, bool anyInput) const;
+    void runNode(int index, int queueIndex);
+    void finishNode(int index, int queueIndex, bool producedAudio, bool slept);
+    void mixSinks(juce::AudioBuffer<float>& output, int startSample, int numSamples);
+
+    std::array<Node, maxNodes> nodes;
+    int numNodes = 0;
+    std::vector<int> sources;               // nodes with no inputs
+    std::array<WorkQueue, maxWorkers + 1> queues;   // [0] belongs to the audio thread
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<float> gainRamp;
+    double sampleRate = 44100.0;
+    bool prepared = false;
+
+    static constexpr float silenceThreshold = 1.0e-5f;   // -100 dB
+    static constexpr int alwaysSilent = 1 << 30;
+
+    // The current segment; written before its first node is queued
+    const juce::MidiBuffer* segmentMidi = nullptr;
+    int segmentStart = 0;
+    int segmentLength = 0;
+    alignas(64) std::atomic<int> completed{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EngineGraph)
+};
@@ -0,0 +1,73 @@
+// Core/EngineNodes.h
+#pragma once
+
+#include <JuceHeader.h>
+#include "EngineGraph.h"
+#include "ForgeProcessor.h"
+#include "PaintEngine.h"
+#include "CanvasProcessor.h"
+
+//==============================================================================
+// EngineGraph nodes for the plugin's engines. The engines themselves live in
+// the processor; these only adapt them to the graph.
+
+class ForgeNode : public EngineNode
+{
+public:
+    explicit ForgeNode(ForgeProcessor& p) : forge(p) {}
+
+    void prepare(double sampleRate, int, int maxBlockSize) override { forge.prepareToPlay(sampleRate, maxBlockSize); }
+
+    void render(juce::AudioBuffer<float>& bus, const juce::MidiBuffer& midi, int startSample, int numSamples) override
+    {
+        forge.processRange(bus, midi, startSample, numSamples);
+    }
+
+    // A note-on in the segment wakes it up
+    bool isIdle(const juce::MidiBuffer& midi, int startSample, int numSamples) const override
+    {
+        const auto next = midi.findNextSamplePosition(startSample);
+        return forge.isIdle() && (next == midi.cend() || (*next).samplePosition >= startSample + numSamples);
+    }
+
+private:
+    ForgeProcessor& forge;
+};
+
+class PaintNode : public EngineNode
+{
+public:
+    explicit PaintNode(PaintEngine& e) : engine(e) {}
+
+    void prepare(double sampleRate, int, int maxBlockSize) override { engine.prepareToPlay(sampleRate, maxBlockSize); }
+
+    void render(juce::AudioBuffer<float>& bus, const juce::MidiBuffer&, int startSample, int numSamples) override
+    {
+        juce::AudioBuffer<float> segment(bus.getArrayOfWritePointers(), bus.getNumChannels(), startSample, numSamples);
+        engine.processBlock(segment);
+    }
+
+    bool isIdle(const juce::MidiBuffer&, int, int) const override { return engine.isIdle(); }
+
+private:
+    PaintEngine& engine;
+};
+
+class CanvasNode : public EngineNode
+{
+public:
+    explicit CanvasNode(CanvasProcessor& p) : canvas(p) {}
+
+    void prepare(double sampleRate, int, int maxBlockSize) override { canvas.prepareToPlay(sampleRate, maxBlockSize); }
+
+    void render(juce::AudioBuffer<float>& bus, const juce::MidiBuffer&, int startSample, int numSamples) override
+    {
+        juce::AudioBuffer<float> segment(bus.getArrayOfWritePointers(), bus.getNumChannels(), startSample, numSamples);
+        canvas.processBlock(segment);
+    }
+
+    bool isIdle(const juce::MidiBuffer&, int, int) const override { return !canvas.isProducingAudio(); }
+
+private:
+    CanvasProcessor& canvas;
+};
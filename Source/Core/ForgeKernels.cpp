@@ -0,0 +1,304 @@
+// Core/ForgeKernels.cpp
+#include "ForgeKernels.h"
+#include "SimdSupport.h"
+#include <array>
+#include <vector>
+
+namespace ForgeKernels
+{
+
+namespace
+{
+    //==========================================================================
+    // Polyphase windowed-sinc coefficients.
+    // One table per cutoff band; each table holds numPhases + 1 rows of
+    // numTaps coefficients so the kernel can blend neighbouring phases.
+    struct SincTable
+    {
+        static constexpr int numTaps = 16;
+        static constexpr int tapsBefore = numTaps / 2 - 1;
+        static constexpr int numPhases = 256;
+        static constexpr int numBands = 5;
+
+        // Largest read step each band is designed for
+        static constexpr std::array<double, numBands> bandStep{ 1.0, 1.5, 2.0, 3.0, 4.0 };
+
+        std::array<std::vector<float>, numBands> bands;
+
+        SincTable()
+        {
+            constexpr double passband = 0.9;   // fraction of Nyquist kept at step 1
+            constexpr double kaiserBeta = 8.0;
+
+            for (int b = 0; b < numBands; ++b)
+            {
+                const double cutoff = passband / bandStep[(size_t)b];
+                auto& table = bands[(size_t)b];
+                table.resize((size_t)(numPhases + 1) * numTaps);
+
+                for (int p = 0; p <= numPhases; ++p)
+                {
+                    const double frac = (double)p / numPhases;
+                    float* row = table.data() + (size_t)p * numTaps;
+                    double sum = 0.0;
+
+                    for (int j = 0; j < numTaps; ++j)
+                    {
+                        const double t = (double)(j - tapsBefore) - frac;
+                        const double x = juce::MathConstants<double>::pi * cutoff * t;
+                        const double sinc = std::abs(x) < 1.0e-9 ? 1.0 : std::sin(x) / x;
+                        const double w = t / (numTaps / 2);
+                        const double window = std::abs(w) >= 1.0 ? 0.0
+                                            : besselI0(kaiserBeta * std::sqrt(1.0 - w * w)) / besselI0(kaiserBeta);
+
+                        row[j] = (float)(sinc * window);
+                        sum += row[j];
+                    }
+
+                    // Unity DC gain for every phase
+                    for (int j = 0; j < numTaps; ++j)
+                        row[j] = (float)(row[j] / sum);
+                }
+            }
+        }
+
+        const float* getBand(double step) const noexcept
+        {
+            int b = 0;
+            while (b < numBands - 1 && step > bandStep[(size_t)b] * 1.0001)
+                ++b;
+            return bands[(size_t)b].data();
+        }
+
+        static double besselI0(double x)
+        {
+            double sum = 1.0, term = 1.0;
+            for (int k = 1; k < 32; ++k)
+            {
+                term *= (x / (2.0 * k)) * (x / (2.0 * k));
+                sum += term;
+            }
+            return sum;
+        }
+
+        static const SincTable& get()
+        {
+            static const SincTable table;
+            return table;
+        }
+    };
+
+    //==========================================================================
+    // 16-tap inner product with phase-blended coefficients
+    inline float sincDot(const float* src, const float* c0, float phaseFrac) noexcept
+    {
+        const float* c1 = c0 + SincTable::numTaps;
+
+#if ARTEFACT_SIMD_AVX2
+        const __m256 f = _mm256_set1_ps(phaseFrac);
+        const __m256 a0 = _mm256_loadu_ps(c0), a1 = _mm256_loadu_ps(c0 + 8);
+        const __m256 k0 = _mm256_add_ps(a0, _mm256_mul_ps(f, _mm256_sub_ps(_mm256_loadu_ps(c1), a0)));
+        const __m256 k1 = _mm256_add_ps(a1, _mm256_mul_ps(f, _mm256_sub_ps(_mm256_loadu_ps(c1 + 8), a1)));
+        const __m256 acc = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(src), k0),
+                                         _mm256_mul_ps(_mm256_loadu_ps(src + 8), k1));
+        __m128 s = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+        s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+        s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 0x55));
+        return _mm_cvtss_f32(s);
+#elif ARTEFACT_SIMD_SSE2
+        const __m128 f = _mm_set1_ps(phaseFrac);
+        __m128 acc = _mm_setzero_ps();
+        for (int j = 0; j < SincTable::numTaps; j += 4)
+        {
+            const __m128 a = _mm_loadu_ps(c0 + j);
+            const __m128 k = _mm_add_ps(a, _mm_mul_ps(f, _mm_sub_ps(_mm_loadu_ps(c1 + j), a)));
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(src + j), k));
+        }
+        acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+        acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 0x55));
+        return _mm_cvtss_f32(acc);
+#elif ARTEFACT_SIMD_NEON
+        float32x4_t acc = vdupq_n_f32(0.0f);
+        for (int j = 0; j < SincTable::numTaps; j += 4)
+        {
+            const float32x4_t a = vld1q_f32(c0 + j);
+            const float32x4_t k = vmlaq_n_f32(a, vsubq_f32(vld1q_f32(c1 + j), a), phaseFrac);
+            acc = vmlaq_f32(acc, vld1q_f32(src + j), k);
+        }
+        const float32x2_t s = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+        return vget_lane_f32(vpadd_f32(s, s), 0);
+#else
+        float acc = 0.0f;
+        for (int j = 0; j < SincTable::numTaps; ++j)
+            acc += src[j] * (c0[j] + phaseFrac * (c1[j] - c0[j]));
+        return acc;
+#endif
+    }
+}
+
+//==============================================================================
+Reach getReach(Interpolation type) noexcept
+{
+    switch (type)
+    {
+    case Interpolation::Linear:  return { 0, 1 };
+    case Interpolation::Hermite: return { 1, 2 };
+    case Interpolation::Sinc:    return { SincTable::tapsBefore, SincTable::numTaps - SincTable::tapsBefore - 1 };
+    }
+    return { 0, 1 };
+}
+
+void prepareTables()
+{
+    SincTable::get();
+}
+
+//==============================================================================
+void interpolateLinear(const float* window, const int* index, const float* frac,
+                       float* dest, int numSamples) noexcept
+{
+    int i = 0;
+
+#if ARTEFACT_SIMD_AVX2
+    for (; i + 8 <= numSamples; i += 8)
+    {
+        const __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(index + i));
+        const __m256 a = _mm256_i32gather_ps(window, idx, 4);
+        const __m256 b = _mm256_i32gather_ps(window + 1, idx, 4);
+        const __m256 f = _mm256_loadu_ps(frac + i);
+        _mm256_storeu_ps(dest + i, _mm256_add_ps(a, _mm256_mul_ps(f, _mm256_sub_ps(b, a))));
+    }
+#endif
+
+    for (; i < numSamples; ++i)
+    {
+        const float a = window[index[i]];
+        const float b = window[index[i] + 1];
+        dest[i] = a + frac[i] * (b - a);
+    }
+}
+
+void interpolateHermite(const float* window, const int* index, const float* frac,
+                        float* dest, int numSamples) noexcept
+{
+    int i = 0;
+
+#if ARTEFACT_SIMD_AVX2
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 oneHalf = _mm256_set1_ps(1.5f);
+    const __m256 two = _mm256_set1_ps(2.0f);
+    const __m256 twoHalf = _mm256_set1_ps(2.5f);
+
+    for (; i + 8 <= numSamples; i += 8)
+    {
+        const __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(index + i));
+        const __m256 xm1 = _mm256_i32gather_ps(window - 1, idx, 4);
+        const __m256 x0  = _mm256_i32gather_ps(window,     idx, 4);
+        const __m256 x1  = _mm256_i32gather_ps(window + 1, idx, 4);
+        const __m256 x2  = _mm256_i32gather_ps(window + 2, idx, 4);
+        const __m256 f   = _mm256_loadu_ps(frac + i);
+
+        const __m256 c1 = _mm256_mul_ps(half, _mm256_sub_ps(x1, xm1));
+        const __m256 c2 = _mm256_sub_ps(_mm256_add_ps(xm1, _mm256_mul_ps(two, x1)),
+                                        _mm256_add_ps(_mm256_mul_ps(twoHalf, x0), _mm256_mul_ps(half, x2)));
+        const __m256 c3 = _mm256_add_ps(_mm256_mul_ps(half, _mm256_sub_ps(x2, xm1)),
+                                        _mm256_mul_ps(oneHalf, _mm256_sub_ps(x0, x1)));
+
+        __m256 y = _mm256_add_ps(_mm256_mul_ps(c3, f), c2);
+        y = _mm256_add_ps(_mm256_mul_ps(y, f), c1);
+        y = _mm256_add_ps(_mm256_mul_ps(y, f), x0);
+        _mm256_storeu_ps(dest + i, y);
+    }
+#endif
+
+    for (; i < numSamples; ++i)
+    {
+        const float* x = window + index[i];
+        const float f = frac[i];
+        const float c1 = 0.5f * (x[1] - x[-1]);
+        const float c2 = x[-1] - 2.5f * x[0] + 2.0f * x[1] - 0.5f * x[2];
+        const float c3 = 0.5f * (x[2] - x[-1]) + 1.5f * (x[0] - x[1]);
+        dest[i] = ((c3 * f + c2) * f + c1) * f + x[0];
+    }
+}
+
+void interpolateSinc(const float* window, const int* index, const float* frac,
+                     float* dest, int numSamples, double step) noexcept
+{
+    const float* table = SincTable::get().getBand(step);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float phase = frac[i] * (float)SincTable::numPhases;
+        const int row = juce::jmin((int)phase, SincTable::numPhases - 1);
+
+        dest[i] = sincDot(window + index[i] - SincTable::tapsBefore,
+                          table + (size_t)row * SincTable::numTaps,
+                          phase - (float)row);
+    }
+}
+
+//==============================================================================
+float dotProduct(const float* a, const float* b, int numSamples) noexcept
+{
+    int i = 0;
+    float sum = 0.0f;
+
+#if ARTEFACT_SIMD_AVX2
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+    for (; i + 16 <= numSamples; i += 16)
+    {
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+        acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8)));
+    }
+    const __m256 acc = _mm256_add_ps(acc0, acc1);
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 0x55));
+    sum += _mm_cvtss_f32(s);
+#endif
+
+#if ARTEFACT_SIMD_SSE2
+    __m128 acc4 = _mm_setzero_ps();
+    for (; i + 4 <= numSamples; i += 4)
+        acc4 = _mm_add_ps(acc4, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    acc4 = _mm_add_ps(acc4, _mm_movehl_ps(acc4, acc4));
+    acc4 = _mm_add_ss(acc4, _mm_shuffle_ps(acc4, acc4, 0x55));
+    sum += _mm_cvtss_f32(acc4);
+#elif ARTEFACT_SIMD_NEON
+    float32x4_t acc4 = vdupq_n_f32(0.0f);
+    for (; i + 4 <= numSamples; i += 4)
+        acc4 = vmlaq_f32(acc4, vld1q_f32(a + i), vld1q_f32(b + i));
+    const float32x2_t s2 = vadd_f32(vget_low_f32(acc4), vget_high_f32(acc4));
+    sum += vget_lane_f32(vpadd_f32(s2, s2), 0);
+#endif
+
+    for (; i < numSamples; ++i)
+        sum += a[i] * b[i];
+
+    return sum;
+}
+
+//==============================================================================
+void applyDrive(float* data, int numSamples, float drive) noexcept
+{
+    if (drive <= 1.0f)
+        return;
+
+    const float inverseDrive = 1.0f / drive;
+    for (int i = 0; i < numSamples; ++i)
+        data[i] = fastTanh(data[i] * drive) * inverseDrive;
+}
+
+void applyCrush(float* data, int numSamples, float bits) noexcept
+{
+    if (bits >= 16.0f)
+        return;
+
+    const float scale = std::pow(2.0f, bits - 1.0f);
+    const float inverseScale = 1.0f / scale;
+    for (int i = 0; i < numSamples; ++i)
+        data[i] = fastRound(data[i] * scale) * inverseScale;
+}
+
+} // namespace ForgeKernels
@@ -0,0 +1,66 @@
+// Core/ForgeKernels.h
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+// Block kernels shared by the Forge voice renderers.
+// All of them work on a decoded read window: index[i] is the integer read
+// position inside that window and frac[i] the fractional part.
+namespace ForgeKernels
+{
+    enum class Interpolation
+    {
+        Linear = 0,  // 2-point, cheapest
+        Hermite,     // 4-point cubic Hermite
+        Sinc         // 16-tap polyphase Kaiser-windowed sinc, band-limited to the pitch
+    };
+
+    // How many window samples an interpolator reads before and after index[i]
+    struct Reach
+    {
+        int before = 0;
+        int after = 0;
+    };
+
+    Reach getReach(Interpolation type) noexcept;
+
+    // Builds the shared sinc tables; call from prepare(), never from the audio thread
+    void prepareTables();
+
+    void interpolateLinear(const float* window, const int* index, const float* frac,
+                           float* dest, int numSamples) noexcept;
+
+    void interpolateHermite(const float* window, const int* index, const float* frac,
+                            float* dest, int numSamples) noexcept;
+
+    // step is the largest read increment in the block; above 1 the kernel's
+    // cutoff drops accordingly so pitched-up material does not alias.
+    void interpolateSinc(const float* window, const int* index, const float* frac,
+                         float* dest, int numSamples, double step) noexcept;
+
+    // Sum of a[i] * b[i]; the correlation step of ForgePsola's pitch tracker
+    float dotProduct(const float* a, const float* b, int numSamples) noexcept;
+
+    // Soft clip, tanh(x * drive) / drive; a no-op at drive 1
+    void applyDrive(float* data, int numSamples, float drive) noexcept;
+
+    // Quantise to the given bit depth; a no-op at 16 bits
+    void applyCrush(float* data, int numSamples, float bits) noexcept;
+
+    // Fast tanh, accurate to ~1e-4 and branch-free so loops over it vectorise
+    inline float fastTanh(float x) noexcept
+    {
+        x = juce::jlimit(-4.97f, 4.97f, x);
+        const float x2 = x * x;
+        return x * (135135.0f + x2 * (17325.0f + x2 * (378.0f + x2)))
+                 / (135135.0f + x2 * (62370.0f + x2 * (3150.0f + x2 * 28.0f)));
+    }
+
+    // Round to nearest without a libm call, valid for |x| < 2^22
+    inline float fastRound(float x) noexcept
+    {
+        constexpr float magic = 12582912.0f; // 1.5 * 2^23
+        return (x + magic) - magic;
+    }
+}
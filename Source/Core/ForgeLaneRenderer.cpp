@@ -0,0 +1,315 @@
+// Core/ForgeLaneRenderer.cpp
+#include "ForgeLaneRenderer.h"
+#include "SimdSupport.h"
+
+void ForgeLaneRenderer::prepare(double, int)
+{
+    windows.assign((size_t)numLanes * laneStride, 0.0f);
+    laneIndex.assign((size_t)maxChunk * numLanes, 0);
+    laneFrac.assign((size_t)maxChunk * numLanes, 0.0f);
+    laneGain.assign((size_t)maxChunk * numLanes, 0.0f);
+}
+
+bool ForgeLaneRenderer::isLaneExact(const ForgeVoice& voice)
+{
+    return voice.interpolation != ForgeVoice::Interpolation::Sinc && voice.isClean() && !voice.isStretching();
+}
+
+//==============================================================================
+void ForgeLaneRenderer::process(std::array<ForgeVoice, numLanes>& voices, juce::AudioBuffer<float>& output,
+                                int startSample, int numSamples)
+{
+    std::array<ForgeVoice*, numLanes> lanes;
+    for (int v = 0; v < numLanes; ++v)
+        lanes[(size_t)v] = &voices[(size_t)v];
+
+    process(lanes.data(), numLanes, output, startSample, numSamples);
+}
+
+void ForgeLaneRenderer::process(ForgeVoice* const* voices, int numVoices, juce::AudioBuffer<float>& output,
+                                int startSample, int numSamples)
+{
+    jassert(numVoices <= numLanes);
+
+    if (windows.empty())
+        return;
+
+    bool anyActive = false;
+
+    for (int v = 0; v < numLanes; ++v)
+    {
+        active[(size_t)v] = v < numVoices && voices[v] != nullptr
+                            && voices[v]->isPlaying && voices[v]->hasSample();
+
+        if (!active[(size_t)v])
+            continue;
+
+        auto& voice = *voices[v];
+        anyActive = true;
+        voice.pitchSmooth.setTargetValue(voice.pitch);
+        voice.volumeSmooth.setTargetValue(voice.volume);
+        voice.nonlinearEngaged = false; // its oversampler is skipped while in lanes
+        voice.nonlinearMix.setCurrentAndTargetValue(voice.isClean() ? 0.0f : 1.0f);
+
+        hermiteMask[(size_t)v] = voice.interpolation == ForgeVoice::Interpolation::Linear ? 0.0f : 1.0f;
+        driveAmount[(size_t)v] = voice.drive;
+        driveMask[(size_t)v] = voice.drive > 1.0f ? 1.0f : 0.0f;
+        crushScale[(size_t)v] = std::pow(2.0f, voice.crushBits - 1.0f);
+        crushMask[(size_t)v] = voice.crushBits < 16.0f ? 1.0f : 0.0f;
+    }
+
+    if (!anyActive)
+        return;
+
+    lanePeak.fill(0.0f);
+
+    int done = 0;
+    while (done < numSamples)
+    {
+        // 1. Chunk length, bounded by the fastest playhead
+        double fastest = 1.0e-6;
+        for (int v = 0; v < numLanes; ++v)
+        {
+            if (active[(size_t)v])
+            {
+                const auto& voice = *voices[v];
+                fastest = juce::jmax(fastest, voice.playbackRate * juce::jmax(voice.pitchSmooth.getCurrentValue(),
+                                                                                voice.pitchSmooth.getTargetValue()));
+            }
+        }
+
+        const int chunk = juce::jlimit(1, juce::jmin(numSamples - done, maxChunk),
+                                       static_cast<int>((laneStride - windowGuard) / fastest));
+
+        // 2. Playheads and gains for every lane, laid out [sample][lane]
+        for (int v = 0; v < numLanes; ++v)
+        {
+            const int laneBase = v * laneStride + reachBefore;
+
+            if (!active[(size_t)v])
+            {
+                for (int i = 0; i < chunk; ++i)
+                {
+                    const size_t slot = (size_t)(i * numLanes + v);
+                    laneIndex[slot] = laneBase;
+                    laneFrac[slot] = 0.0f;
+                    laneGain[slot] = 0.0f;
+                }
+                continue;
+            }
+
+            auto& voice = *voices[v];
+            windowStart[(size_t)v] = static_cast<int>(voice.position);
+            double localPos = voice.position - windowStart[(size_t)v];
+            int lastIndex = 0;
+
+            if (voice.pitchSmooth.isSmoothing())
+            {
+                for (int i = 0; i < chunk; ++i)
+                {
+                    const size_t slot = (size_t)(i * numLanes + v);
+                    lastIndex = static_cast<int>(localPos);
+                    laneIndex[slot] = laneBase + lastIndex;
+                    laneFrac[slot] = static_cast<float>(localPos - lastIndex);
+                    localPos += voice.playbackRate * voice.pitchSmooth.getNextValue();
+                }
+            }
+            else
+            {
+                const double step = voice.playbackRate * voice.pitchSmooth.getTargetValue();
+                for (int i = 0; i < chunk; ++i)
+                {
+                    const size_t slot = (size_t)(i * numLanes + v);
+                    const double p = localPos + step * i;
+                    lastIndex = static_cast<int>(p);
+                    laneIndex[slot] = laneBase + lastIndex;
+                    laneFrac[slot] = static_cast<float>(p - lastIndex);
+                }
+                localPos += step * chunk;
+            }
+
+            windowLength[(size_t)v] = lastIndex + windowGuard;
+
+            const bool smoothing = voice.volumeSmooth.isSmoothing();
+            const float gain = voice.volumeSmooth.getTargetValue();
+            for (int i = 0; i < chunk; ++i)
+                laneGain[(size_t)(i * numLanes + v)] = smoothing ? voice.volumeSmooth.getNextValue() : gain;
+
+            voice.position = windowStart[(size_t)v] + localPos;
+            const int sourceLength = voice.getSource().getNumSamples();
+            if (voice.position >= sourceLength)
+                voice.position = std::fmod(voice.position, static_cast<double>(sourceLength));
+        }
+
+        // 3. Decode every lane's window and render, one output channel at a time.
+        //    Mono sources feed every output channel, as in ForgeVoice::process.
+        for (int ch = 0; ch < output.getNumChannels(); ++ch)
+        {
+            for (int v = 0; v < numLanes; ++v)
+            {
+                if (!active[(size_t)v])
+                    continue;
+
+                const auto& source = voices[v]->getSource();
+                source.readWindow(ch % juce::jmin(source.getNumChannels(), 2),
+                                   windowStart[(size_t)v] - reachBefore, windowLength[(size_t)v],
+                                   windows.data() + (size_t)v * laneStride);
+            }
+
+            renderLanes(output.getWritePointer(ch, startSample + done), chunk);
+        }
+
+        done += chunk;
+    }
+
+    for (int v = 0; v < numLanes; ++v)
+    {
+        if (active[(size_t)v])
+        {
+            voices[v]->peakLevel = juce::jmax(voices[v]->peakLevel, lanePeak[(size_t)v]);
+            voices[v]->finishRelease();
+        }
+    }
+}
+
+//==============================================================================
+// One pass over the chunk: every output sample is one vector of eight voices
+void ForgeLaneRenderer::renderLanes(float* dest, int numSamples) noexcept
+{
+    const float* w = windows.data();
+
+#if ARTEFACT_SIMD_AVX2
+    const __m256 threshold = _mm256_set1_ps(0.5f);
+    const __m256 useHermite = _mm256_cmp_ps(_mm256_loadu_ps(hermiteMask.data()), threshold, _CMP_GT_OQ);
+    const __m256 useDrive = _mm256_cmp_ps(_mm256_loadu_ps(driveMask.data()), threshold, _CMP_GT_OQ);
+    const __m256 useCrush = _mm256_cmp_ps(_mm256_loadu_ps(crushMask.data()), threshold, _CMP_GT_OQ);
+
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 drive = _mm256_loadu_ps(driveAmount.data());
+    const __m256 inverseDrive = _mm256_div_ps(one, drive);
+    const __m256 scale = _mm256_loadu_ps(crushScale.data());
+    const __m256 inverseScale = _mm256_div_ps(one, scale);
+
+    const __m256 half = _mm256_set1_ps(0.5f), oneHalf = _mm256_set1_ps(1.5f);
+    const __m256 two = _mm256_set1_ps(2.0f), twoHalf = _mm256_set1_ps(2.5f);
+    const __m256 clipHi = _mm256_set1_ps(4.97f), clipLo = _mm256_set1_ps(-4.97f);
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+    __m256 peak = _mm256_loadu_ps(lanePeak.data());
+
+    for (int i = 0; i < numSamples; i += 8)
+    {
+        const int count = juce::jmin(8, numSamples - i);
+        __m256 y[8];
+
+        for (int k = 0; k < 8; ++k)
+        {
+            if (k >= count)
+            {
+                y[k] = _mm256_setzero_ps();
+                continue;
+            }
+
+            const size_t row = (size_t)(i + k) * numLanes;
+            const __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(laneIndex.data() + row));
+            const __m256 f = _mm256_loadu_ps(laneFrac.data() + row);
+
+            const __m256 xm1 = _mm256_i32gather_ps(w - 1, idx, 4);
+            const __m256 x0  = _mm256_i32gather_ps(w,     idx, 4);
+            const __m256 x1  = _mm256_i32gather_ps(w + 1, idx, 4);
+            const __m256 x2  = _mm256_i32gather_ps(w + 2, idx, 4);
+
+            // Linear and Hermite share the gathered points; pick per lane
+            const __m256 linear = _mm256_add_ps(x0, _mm256_mul_ps(f, _mm256_sub_ps(x1, x0)));
+
+            const __m256 c1 = _mm256_mul_ps(half, _mm256_sub_ps(x1, xm1));
+            const __m256 c2 = _mm256_sub_ps(_mm256_add_ps(xm1, _mm256_mul_ps(two, x1)),
+                                            _mm256_add_ps(_mm256_mul_ps(twoHalf, x0), _mm256_mul_ps(half, x2)));
+            const __m256 c3 = _mm256_add_ps(_mm256_mul_ps(half, _mm256_sub_ps(x2, xm1)),
+                                            _mm256_mul_ps(oneHalf, _mm256_sub_ps(x0, x1)));
+            __m256 hermite = _mm256_add_ps(_mm256_mul_ps(c3, f), c2);
+            hermite = _mm256_add_ps(_mm256_mul_ps(hermite, f), c1);
+            hermite = _mm256_add_ps(_mm256_mul_ps(hermite, f), x0);
+
+            __m256 v = _mm256_blendv_ps(linear, hermite, useHermite);
+
+            // Drive: tanh(v * drive) / drive on the lanes that want it
+            const __m256 d = _mm256_min_ps(clipHi, _mm256_max_ps(clipLo, _mm256_mul_ps(v, drive)));
+            const __m256 d2 = _mm256_mul_ps(d, d);
+            const __m256 num = _mm256_mul_ps(d, _mm256_add_ps(_mm256_set1_ps(135135.0f),
+                                   _mm256_mul_ps(d2, _mm256_add_ps(_mm256_set1_ps(17325.0f),
+                                   _mm256_mul_ps(d2, _mm256_add_ps(_mm256_set1_ps(378.0f), d2))))));
+            const __m256 den = _mm256_add_ps(_mm256_set1_ps(135135.0f),
+                                   _mm256_mul_ps(d2, _mm256_add_ps(_mm256_set1_ps(62370.0f),
+                                   _mm256_mul_ps(d2, _mm256_add_ps(_mm256_set1_ps(3150.0f),
+                                   _mm256_mul_ps(d2, _mm256_set1_ps(28.0f)))))));
+            v = _mm256_blendv_ps(v, _mm256_mul_ps(_mm256_div_ps(num, den), inverseDrive), useDrive);
+
+            // Crush
+            const __m256 crushed = _mm256_mul_ps(_mm256_round_ps(_mm256_mul_ps(v, scale),
+                                                                 _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC),
+                                                 inverseScale);
+            v = _mm256_blendv_ps(v, crushed, useCrush);
+
+            y[k] = _mm256_mul_ps(v, _mm256_loadu_ps(laneGain.data() + row));
+            peak = _mm256_max_ps(peak, _mm256_andnot_ps(signBit, y[k]));
+        }
+
+        // Transpose-reduce: eight lane vectors -> eight per-sample sums
+        const __m256 t0 = _mm256_hadd_ps(_mm256_hadd_ps(y[0], y[1]), _mm256_hadd_ps(y[2], y[3]));
+        const __m256 t1 = _mm256_hadd_ps(_mm256_hadd_ps(y[4], y[5]), _mm256_hadd_ps(y[6], y[7]));
+        const __m256 sums = _mm256_add_ps(_mm256_permute2f128_ps(t0, t1, 0x20),
+                                          _mm256_permute2f128_ps(t0, t1, 0x31));
+
+        if (count == 8)
+        {
+            _mm256_storeu_ps(dest + i, _mm256_add_ps(_mm256_loadu_ps(dest + i), sums));
+        }
+        else
+        {
+            alignas(32) float tail[8];
+            _mm256_store_ps(tail, sums);
+            for (int k = 0; k < count; ++k)
+                dest[i + k] += tail[k];
+        }
+    }
+
+    _mm256_storeu_ps(lanePeak.data(), peak);
+#else
+    for (int i = 0; i < numSamples; ++i)
+    {
+        float sum = 0.0f;
+
+        for (int v = 0; v < numLanes; ++v)
+        {
+            const size_t slot = (size_t)(i * numLanes + v);
+            const float* x = w + laneIndex[slot];
+            const float f = laneFrac[slot];
+
+            float y;
+            if (hermiteMask[(size_t)v] > 0.5f)
+            {
+                const float c1 = 0.5f * (x[1] - x[-1]);
+                const float c2 = x[-1] - 2.5f * x[0] + 2.0f * x[1] - 0.5f * x[2];
+                const float c3 = 0.5f * (x[2] - x[-1]) + 1.5f * (x[0] - x[1]);
+                y = ((c3 * f + c2) * f + c1) * f + x[0];
+            }
+            else
+            {
+                y = x[0] + f * (x[1] - x[0]);
+            }
+
+            if (driveMask[(size_t)v] > 0.5f)
+                y = ForgeKernels::fastTanh(y * driveAmount[(size_t)v]) / driveAmount[(size_t)v];
+
+            if (crushMask[(size_t)v] > 0.5f)
+                y = ForgeKernels::fastRound(y * crushScale[(size_t)v]) / crushScale[(size_t)v];
+
+            y *= laneGain[slot];
+            lanePeak[(size_t)v] = juce::jmax(lanePeak[(size_t)v], std::abs(y));
+            sum += y;
+        }
+
+        dest[i] += sum;
+    }
+#endif
+}
@@ -0,0 +1,66 @@
+// Core/ForgeLaneRenderer.h
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+#include "ForgeVoice.h"
+
+//==============================================================================
+// Renders the eight Forge slots together, one voice per SIMD lane.
+// Playheads, interpolation, drive/crush and gain for all slots advance in a
+// single pass; stopped or empty slots are masked out.
+//
+// Clean Linear and Hermite slots sound the same here as on their own. Sinc
+// slots are rendered with Hermite, stretching slots are resampled, and
+// drive/crush runs at base rate instead of through the voice's oversampler,
+// so those slots only take this path when the processor is forced into it.
+class ForgeLaneRenderer
+{
+public:
+    static constexpr int numLanes = 8;
+
+    ForgeLaneRenderer() = default;
+
+    void prepare(double sampleRate, int blockSize);
+    void process(std::array<ForgeVoice, numLanes>& voices, juce::AudioBuffer<float>& output,
+                 int startSample, int numSamples);
+
+    // Up to numLanes voices from anywhere, e.g. a batch of pool voices
+    void process(ForgeVoice* const* voices, int numVoices, juce::AudioBuffer<float>& output,
+                 int startSample, int numSamples);
+
+    // True when the lane path renders this voice the same way ForgeVoice::process does
+    static bool isLaneExact(const ForgeVoice& voice);
+
+private:
+    static constexpr int maxChunk = 64;
+    static constexpr int maxStepInWindow = 4;
+    static constexpr int reachBefore = 1;   // Hermite reach, the widest lane interpolator
+    static constexpr int reachAfter = 2;
+    static constexpr int windowGuard = reachBefore + reachAfter + 1;
+    static constexpr int laneStride = maxChunk * maxStepInWindow + windowGuard;
+
+    void renderLanes(float* dest, int numSamples) noexcept;
+
+    // Decoded read windows for one output channel, laneStride floats per lane
+    std::vector<float> windows;
+
+    // Per-sample lane data, interleaved as [sample][lane]
+    std::vector<int>   laneIndex;
+    std::vector<float> laneFrac;
+    std::vector<float> laneGain;
+
+    // Per-lane block parameters
+    std::array<bool,  numLanes> active{};
+    std::array<int,   numLanes> windowStart{};
+    std::array<int,   numLanes> windowLength{};
+    std::array<float, numLanes> hermiteMask{};   // 1 = Hermite, 0 = linear
+    std::array<float, numLanes> driveAmount{};
+    std::array<float, numLanes> driveMask{};
+    std::array<float, numLanes> crushScale{};
+    std::array<float, numLanes> crushMask{};
+    std::array<float, numLanes> lanePeak{};      // loudest output per lane, for the level meters
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ForgeLaneRenderer)
+};
@@ -1,30 +1,90 @@
-﻿#pragma once
-#include <JuceHeader.h>
-#include <array>
-#include "ForgeVoice.h"
-#include "Core/Commands.h"
-
-//==============================================================================
-// Manages eight voices, sample loading, and host-sync parameters
-class ForgeProcessor
-{
-public:
-    ForgeProcessor();
-    ~ForgeProcessor();
-
-    // lifecycle
-    void prepareToPlay(double sampleRate, int samplesPerBlock);
-    void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&);
-
-    // commands
-    void loadSampleIntoSlot(int slotIdx, const juce::File& file);
-    ForgeVoice& getVoice(int index);
-    void        setHostBPM(double bpm);
-
-private:
-    std::array<ForgeVoice, 8> voices;           // fixed-size, copy-safe
-    juce::AudioFormatManager  formatManager;
-    float                     hostBPM = 120.0f;
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ForgeProcessor)
-};
+﻿#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include "ForgeVoice.h"
+#include "ForgeLaneRenderer.h"
+#include "ForgeVoicePool.h"
+#include "Core/Commands.h"
+
+//==============================================================================
+// Manages eight voices, sample loading, and host-sync parameters
+class ForgeProcessor
+{
+public:
+    // How loaded samples are held in memory
+    enum class SampleStorageMode
+    {
+        Full = 0,   // always 32-bit float
+        Lossless,   // 16-bit sources as int16, everything else float
+        Compact     // 16-bit sources as int16, deeper sources as half float
+    };
+
+    // How the eight slots are rendered
+    enum class RenderMode
+    {
+        PerVoice = 0,   // each voice on its own, full quality
+        LaneParallel,   // all slots in one SIMD pass, drive/crush at base rate
+        Auto            // in AVX2 builds, lanes whenever that sounds identical; else per voice
+    };
+
+    // A sample decoded and encoded off the audio thread, ready to swap into a slot
+    struct PreparedSample
+    {
+        SampleStorage storage;
+        juce::String  name;
+        double        originalBPM = 120.0;
+        double        sampleRate = 44100.0;   // the file's; spectral edits map frequencies with it
+        juce::uint32  serial = 0;   // names this load, so edits made for an earlier one are dropped
+    };
+
+    // Resynthesised audio for part of a slot's sample, from a spectral edit
+    struct PreparedSplice
+    {
+        juce::AudioBuffer<float> audio;
+        int           startSample = 0;
+        juce::uint32  serial = 0;   // the PreparedSample::serial it was rendered from
+        SampleStorage storage;      // if set, replaces the slot's storage before the audio goes in
+    };
+
+    static constexpr int maxSpliceSamples = 16384;   // per splice, bounding the audio thread's share
+
+    ForgeProcessor();
+    ~ForgeProcessor();
+
+    // lifecycle
+    void prepareToPlay(double sampleRate, int samplesPerBlock);
+    void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&);
+    void processRange(juce::AudioBuffer<float>&, const juce::MidiBuffer&, int startSample, int numSamples);
+
+    // commands
+    bool prepareSample(const juce::File& file, PreparedSample& dest);    // loader and sample editor threads
+    void installSample(int slotIdx, PreparedSample& sample);            // audio thread
+    void spliceSample(int slotIdx, PreparedSplice& splice);              // audio thread
+    ForgeVoice& getVoice(int index);
+    void        setHostBPM(double bpm);
+    void        setSampleStorageMode(SampleStorageMode mode) { storageMode = mode; }
+    SampleStorageMode getSampleStorageMode() const { return storageMode; }
+    void        setRenderMode(RenderMode mode) { renderMode = mode; }
+    RenderMode  getRenderMode() const { return renderMode; }
+    ForgeVoicePool& getVoicePool() { return voicePool; }
+    bool        isIdle() const;     // nothing sounding, so a block without MIDI renders silence
+
+    // Peak per slot since the last call, slot voice and MIDI notes together; audio thread
+    void takeSlotLevels(std::array<float, 8>& levels, std::array<int, 8>& activeNotes);
+
+private:
+    std::array<ForgeVoice, 8> voices;           // fixed-size, copy-safe
+    ForgeLaneRenderer         laneRenderer;
+    RenderMode                renderMode = RenderMode::Auto;
+    ForgeVoicePool            voicePool;                // MIDI notes
+    juce::AudioFormatManager  formatManager;
+    float                     hostBPM = 120.0f;
+    SampleStorageMode         storageMode = SampleStorageMode::Lossless;
+    std::array<juce::uint32, 8> slotSerials{};          // audio thread; the load each slot holds
+
+    void renderRange(juce::AudioBuffer<float>&, int startSample, int numSamples);
+    bool shouldRenderInLanes() const;
+    static SampleStorage::Format chooseStorageFormat(SampleStorageMode mode, const juce::AudioFormatReader& reader);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ForgeProcessor)
+};
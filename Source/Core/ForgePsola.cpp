@@ -0,0 +1,223 @@
+// Core/ForgePsola.cpp
+#include "ForgePsola.h"
+#include "ForgeKernels.h"
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    // One Hann cycle over 2 * maxPeriod points; shorter grains take every n-th point
+    const std::vector<float>& getHannTable()
+    {
+        static const std::vector<float> table = []
+        {
+            constexpr int size = 2 * ForgePsola::maxPeriod;
+            std::vector<float> t((size_t)size);
+            for (int i = 0; i < size; ++i)
+                t[(size_t)i] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * (float)i / (float)size);
+            return t;
+        }();
+        return table;
+    }
+
+    constexpr float voicingThreshold = 0.6f;   // normalised correlation below which nothing is pitched
+    constexpr float octaveTolerance = 0.85f;   // the shortest lag this close to the best wins, against octave errors
+}
+
+//==============================================================================
+void ForgePsola::prepare()
+{
+    getHannTable();
+
+    overlapAdd.resize(2);
+    for (auto& channel : overlapAdd)
+        channel.assign((size_t)capacity, 0.0f);
+
+    grain.assign((size_t)(2 * maxPeriod), 0.0f);
+    grainWindow.assign((size_t)(2 * maxPeriod), 0.0f);
+    analysis.assign((size_t)analysisLength, 0.0f);
+    decimated.assign((size_t)(analysisLength / decimation), 0.0f);
+    correlation.assign((size_t)(maxPeriod / decimation + 1), 0.0f);
+
+    reset();
+}
+
+void ForgePsola::reset()
+{
+    for (auto& channel : overlapAdd)
+        std::fill(channel.begin(), channel.end(), 0.0f);
+
+    period = unvoicedPeriod;
+    voiced = false;
+    nextMark = 0.0;
+    analysisMark = 0.0;
+    lastEstimate = 0.0;
+    started = false;
+    expectedPosition = -1.0;
+}
+
+//==============================================================================
+void ForgePsola::render(const SampleStorage& source, double position, double rate, float pitch,
+                        juce::AudioBuffer<float>& dest, int numChannels, int numSamples) noexcept
+{
+    jassert(numSamples <= maxChunk);
+    numSamples = juce::jmin(numSamples, maxChunk);
+    numChannels = juce::jmin(numChannels, (int)overlapAdd.size(), source.getNumChannels(), dest.getNumChannels());
+
+    if (overlapAdd.empty() || source.isEmpty() || numChannels <= 0)
+        return;
+
+    const double length = source.getNumSamples();
+    pitch = juce::jlimit(1.0f / maxPitch, maxPitch, pitch);
+
+    // Anything but carrying on from the last call (a new note, a seek) starts over
+    if (expectedPosition >= 0.0)
+    {
+        const double jump = std::fmod(std::abs(position - expectedPosition), length);
+        if (juce::jmin(jump, length - jump) > 1.0)
+            reset();
+    }
+
+    // Every grain that reaches into this block; later ones start at least maxPeriod past it.
+    // Unvoiced grains go down at their own hop: Hann windows a half-length apart sum to one,
+    // where every period / pitch they would sum to pitch and boost or gap noise.
+    while (nextMark < numSamples + maxPeriod)
+    {
+        const int centre = juce::roundToInt(nextMark);
+        addGrain(source, numChannels, centre, position + centre * rate);
+        nextMark += voiced ? (double)period / pitch : (double)period;
+    }
+
+    // Left as laid down: each output period carries one grain, so pitched material keeps its level
+    for (int ch = 0; ch < numChannels; ++ch)
+        juce::FloatVectorOperations::copy(dest.getWritePointer(ch), overlapAdd[(size_t)ch].data(), numSamples);
+
+    const size_t kept = sizeof(float) * (size_t)(capacity - numSamples);
+    for (auto& channel : overlapAdd)
+    {
+        std::memmove(channel.data(), channel.data() + numSamples, kept);
+        juce::FloatVectorOperations::clear(channel.data() + capacity - numSamples, numSamples);
+    }
+
+    nextMark -= numSamples;
+    expectedPosition = std::fmod(position + rate * numSamples, length);
+}
+
+void ForgePsola::addGrain(const SampleStorage& source, int numChannels, int centre, double target) noexcept
+{
+    if (!started || std::abs(target - lastEstimate) >= estimateInterval)
+    {
+        estimatePeriod(source, numChannels, target);
+        lastEstimate = target;
+    }
+
+    // Pitched grains stay a whole number of periods from the last one, so they overlap in phase;
+    // the playhead decides how many periods to skip or repeat
+    if (started && voiced)
+        analysisMark += std::round((target - analysisMark) / period) * period;
+    else
+        analysisMark = std::round(target);
+
+    started = true;
+
+    const int size = 2 * period;
+    const auto& table = getHannTable();
+    for (int j = 0; j < size; ++j)
+        grainWindow[(size_t)j] = table[(size_t)(j * maxPeriod / period)];
+
+    // Only the first grain after reset() reaches back before the block
+    const int first = juce::jmax(0, period - centre);
+    const int destStart = centre - period + first;
+    const int num = size - first;
+    jassert(destStart + num <= capacity);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        source.readWindow(ch, (int)analysisMark - period + first, num, grain.data());
+        juce::FloatVectorOperations::multiply(grain.data(), grainWindow.data() + first, num);
+        juce::FloatVectorOperations::add(overlapAdd[(size_t)ch].data() + destStart, grain.data(), num);
+    }
+}
+
+void ForgePsola::estimatePeriod(const SampleStorage& source, int numChannels, double centre) noexcept
+{
+    // Mono mix of two maximum periods, starting one before the playhead
+    const int start = (int)std::floor(centre) - maxPeriod;
+    source.readWindow(0, start, analysisLength, analysis.data());
+
+    if (numChannels > 1)
+    {
+        source.readWindow(1, start, analysisLength, grain.data());
+        juce::FloatVectorOperations::add(analysis.data(), grain.data(), analysisLength);
+    }
+
+    // Coarse search at a quarter rate: normalised correlation of the first half against every lag
+    const int numDecimated = analysisLength / decimation;
+    for (int i = 0; i < numDecimated; ++i)
+    {
+        const float* x = analysis.data() + i * decimation;
+        decimated[(size_t)i] = x[0] + x[1] + x[2] + x[3];
+    }
+
+    const float* x = decimated.data();
+    const int span = maxPeriod / decimation;
+    const int lowLag = minPeriod / decimation;
+    const float energy = ForgeKernels::dotProduct(x, x, span);
+
+    voiced = false;
+    period = unvoicedPeriod;
+
+    if (energy < 1.0e-8f)
+        return;
+
+    float lagEnergy = ForgeKernels::dotProduct(x + lowLag, x + lowLag, span);
+    float best = 0.0f;
+
+    for (int lag = lowLag; lag <= span; ++lag)
+    {
+        const float r = ForgeKernels::dotProduct(x, x + lag, span);
+        correlation[(size_t)lag] = r / std::sqrt(energy * juce::jmax(lagEnergy, 0.0f) + 1.0e-12f);
+        best = juce::jmax(best, correlation[(size_t)lag]);
+
+        if (lag < span)
+            lagEnergy += x[lag + span] * x[lag + span] - x[lag] * x[lag];
+    }
+
+    if (best < voicingThreshold)
+        return;
+
+    int coarse = lowLag;
+    for (int lag = lowLag; lag <= span; ++lag)
+    {
+        const float c = correlation[(size_t)lag];
+        const bool isPeak = (lag == lowLag || c >= correlation[(size_t)lag - 1])
+                         && (lag == span || c >= correlation[(size_t)lag + 1]);
+
+        if (isPeak && c >= best * octaveTolerance)
+        {
+            coarse = lag;
+            break;
+        }
+    }
+
+    // Refine to the sample at full rate
+    const float* full = analysis.data();
+    const float fullEnergy = ForgeKernels::dotProduct(full, full, maxPeriod);
+    float bestRefined = -1.0f;
+
+    for (int lag = juce::jmax(minPeriod, coarse * decimation - decimation);
+         lag <= juce::jmin(maxPeriod, coarse * decimation + decimation); ++lag)
+    {
+        const float r = ForgeKernels::dotProduct(full, full + lag, maxPeriod);
+        const float e = ForgeKernels::dotProduct(full + lag, full + lag, maxPeriod);
+        const float c = r / std::sqrt(fullEnergy * e + 1.0e-12f);
+
+        if (c > bestRefined)
+        {
+            bestRefined = c;
+            period = lag;
+        }
+    }
+
+    voiced = true;
+}
@@ -0,0 +1,66 @@
+// Core/ForgePsola.h
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+#include "SampleStorage.h"
+
+//==============================================================================
+// Pitch-synchronous overlap-add (TD-PSOLA) for one ForgeVoice.
+//
+// The cheap alternative to ForgeStretcher for monophonic material: voice,
+// bass, single-note leads. A pitch tracker measures the period around the
+// playhead; two-period Hann grains are cut a whole number of periods apart in
+// the source, so consecutive grains line up, and laid down every period / pitch
+// output samples. Tempo follows the playhead and pitch follows the grain
+// spacing, independently. Where no period is found the grains fall back to a
+// fixed length laid down at their own hop, which leaves noise unpitched but
+// keeps it in time and at its level.
+//
+// Like ForgeStretcher it reads straight from the sample and adds no latency.
+// All buffers are allocated in prepare().
+class ForgePsola
+{
+public:
+    static constexpr int maxChunk = 256;          // output samples per render() call
+    static constexpr float maxPitch = 4.0f;
+    static constexpr int minPeriod = 32;          // ~1.4 kHz at 44.1 kHz
+    static constexpr int maxPeriod = 768;         // ~57 Hz
+    static constexpr int unvoicedPeriod = 256;    // grain half-length when nothing is pitched
+
+    ForgePsola() = default;
+
+    void prepare();   // not on the audio thread
+    void reset();     // the next render() starts afresh wherever the playhead is
+
+    // Renders numSamples (up to maxChunk) of the source into dest's first numChannels channels.
+    // position is the playhead at the first sample; it moves rate source samples per output sample.
+    void render(const SampleStorage& source, double position, double rate, float pitch,
+                juce::AudioBuffer<float>& dest, int numChannels, int numSamples) noexcept;
+
+    // The last period measured, 0 while the material is unpitched
+    int getPeriod() const noexcept { return voiced ? period : 0; }
+
+private:
+    void addGrain(const SampleStorage& source, int numChannels, int centre, double target) noexcept;
+    void estimatePeriod(const SampleStorage& source, int numChannels, double centre) noexcept;
+
+    static constexpr int capacity = maxChunk + 2 * maxPeriod + 2;
+    static constexpr int decimation = 4;                       // coarse search runs at a quarter rate
+    static constexpr int analysisLength = 2 * maxPeriod;       // maxPeriod samples, then every lag up to maxPeriod
+    static constexpr int estimateInterval = 256;               // source samples between period measurements
+
+    std::vector<std::vector<float>> overlapAdd;   // per channel; index 0 is the next output sample
+    std::vector<float> grain, grainWindow;        // 2 * maxPeriod
+    std::vector<float> analysis, decimated, correlation;
+
+    int    period = unvoicedPeriod;
+    bool   voiced = false;
+    double nextMark = 0.0;          // output offset of the next grain's centre
+    double analysisMark = 0.0;      // source position of the last grain's centre
+    double lastEstimate = 0.0;      // source position of the last period measurement
+    bool   started = false;         // a grain has been laid since reset()
+    double expectedPosition = -1.0; // where the last render() left the playhead, -1 after reset()
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ForgePsola)
+};
@@ -0,0 +1,248 @@
+// Core/ForgeStretcher.cpp
+#include "ForgeStretcher.h"
+#include "ForgeKernels.h"
+#include "SpectralKernels.h"
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    // Read-only once built, so every voice can use it at once
+    struct SharedEngine
+    {
+        juce::dsp::FFT fft{ ForgeStretcher::fftOrder };
+        std::vector<float> window;
+        float outputGain = 1.0f;
+
+        SharedEngine()
+        {
+            constexpr int size = ForgeStretcher::fftSize;
+
+            window.resize((size_t)size);
+            for (int i = 0; i < size; ++i)
+                window[(size_t)i] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * (float)i / (float)size);
+
+            // Windowed twice, Hann overlaps to a constant; 1.5 at 75%
+            float sum = 0.0f;
+            for (int i = 0; i < size; i += ForgeStretcher::hopSize)
+                sum += window[(size_t)i] * window[(size_t)i];
+
+            outputGain = 1.0f / sum;
+        }
+    };
+
+    const SharedEngine& getEngine()
+    {
+        static const SharedEngine engine;
+        return engine;
+    }
+}
+
+//==============================================================================
+void ForgeStretcher::prepare()
+{
+    getEngine();
+
+    channels.resize(2);
+    for (auto& channel : channels)
+    {
+        channel.overlapAdd.assign((size_t)fftSize, 0.0f);
+        channel.stream.assign((size_t)streamCapacity, 0.0f);
+        channel.synthesisPhase.assign((size_t)numBins, 0.0f);
+    }
+
+    frame.assign((size_t)fftSize * 2, 0.0f);
+    earlier.assign((size_t)fftSize * 2, 0.0f);
+    magnitude.assign((size_t)numBins, 0.0f);
+    phase.assign((size_t)numBins, 0.0f);
+    earlierMagnitude.assign((size_t)numBins, 0.0f);
+    earlierPhase.assign((size_t)numBins, 0.0f);
+    peaks.assign((size_t)numBins, 0);
+    readIndex.assign((size_t)maxChunk, 0);
+    readFrac.assign((size_t)maxChunk, 0.0f);
+
+    reset();
+}
+
+void ForgeStretcher::reset()
+{
+    for (auto& channel : channels)
+    {
+        std::fill(channel.overlapAdd.begin(), channel.overlapAdd.end(), 0.0f);
+        std::fill(channel.stream.begin(), channel.stream.end(), 0.0f);
+    }
+
+    // Stream sample 0 is silence for the interpolator to look back at. The first
+    // frames cover the stream before the playhead and only prime the overlap-add,
+    // so the first output already has every frame over it.
+    readPos = 1.0;
+    numReady = 1;
+    accumStart = numReady - (fftSize - hopSize);
+    hasPhases = false;
+    expectedPosition = -1.0;
+}
+
+//==============================================================================
+void ForgeStretcher::render(const SampleStorage& source, double position, double rate, float pitch,
+                            juce::AudioBuffer<float>& dest, int numChannels, int numSamples) noexcept
+{
+    jassert(numSamples <= maxChunk);
+    numSamples = juce::jmin(numSamples, maxChunk);
+    numChannels = juce::jmin(numChannels, (int)channels.size(), source.getNumChannels(), dest.getNumChannels());
+
+    if (channels.empty() || source.isEmpty() || numChannels <= 0)
+        return;
+
+    const double length = source.getNumSamples();
+    pitch = juce::jlimit(1.0f / maxPitch, maxPitch, pitch);
+
+    // Anything but carrying on from the last call (a new note, a seek) starts a new stream
+    if (expectedPosition >= 0.0)
+    {
+        const double jump = std::fmod(std::abs(position - expectedPosition), length);
+        if (juce::jmin(jump, length - jump) > 1.0)
+            reset();
+    }
+
+    // Vocoder frames until the resampler has everything it will read. Each frame is
+    // centred on where the playhead will be when the output reaches its centre.
+    const double streamRate = rate / pitch;   // source samples per stream sample
+    const int needed = (int)(readPos + pitch * (numSamples - 1)) + 3;
+
+    while (numReady < needed)
+        addFrame(source, numChannels, position + (accumStart + fftSize / 2 - readPos) * streamRate);
+
+    // Back to the original pitch
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const double p = readPos + (double)pitch * i;
+        const int idx = (int)p;
+        readIndex[(size_t)i] = idx;
+        readFrac[(size_t)i] = (float)(p - idx);
+    }
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        ForgeKernels::interpolateHermite(channels[(size_t)ch].stream.data(), readIndex.data(), readFrac.data(),
+                                         dest.getWritePointer(ch), numSamples);
+
+    readPos += (double)pitch * numSamples;
+
+    // Drop what has been read, keeping one sample behind the read position
+    const int drop = (int)readPos - 1;
+    if (drop > 0)
+    {
+        for (auto& channel : channels)
+            std::memmove(channel.stream.data(), channel.stream.data() + drop, sizeof(float) * (size_t)(numReady - drop));
+
+        numReady -= drop;
+        accumStart -= drop;
+        readPos -= drop;
+    }
+
+    expectedPosition = std::fmod(position + rate * numSamples, length);
+}
+
+void ForgeStretcher::addFrame(const SampleStorage& source, int numChannels, double centre) noexcept
+{
+    const auto& engine = getEngine();
+    const int start = (int)std::floor(centre) - fftSize / 2;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto& channel = channels[(size_t)ch];
+
+        // The frame, and the one a hop before it in the source: their phase difference is
+        // how far each partial turns over one output hop
+        source.readWindow(ch, start, fftSize, frame.data());
+        source.readWindow(ch, start - hopSize, fftSize, earlier.data());
+
+        juce::FloatVectorOperations::multiply(frame.data(), engine.window.data(), fftSize);
+        juce::FloatVectorOperations::multiply(earlier.data(), engine.window.data(), fftSize);
+        juce::FloatVectorOperations::clear(frame.data() + fftSize, fftSize);
+        juce::FloatVectorOperations::clear(earlier.data() + fftSize, fftSize);
+
+        engine.fft.performRealOnlyForwardTransform(frame.data(), true);
+        engine.fft.performRealOnlyForwardTransform(earlier.data(), true);
+
+        SpectralKernels::toPolar(frame.data(), magnitude.data(), phase.data(), numBins);
+        SpectralKernels::toPolar(earlier.data(), earlierMagnitude.data(), earlierPhase.data(), numBins);
+
+        lockPhases(channel);
+
+        SpectralKernels::fromPolar(magnitude.data(), channel.synthesisPhase.data(), frame.data(), numBins);
+        engine.fft.performRealOnlyInverseTransform(frame.data());
+        juce::FloatVectorOperations::addWithMultiply(channel.overlapAdd.data(), frame.data(), engine.window.data(), fftSize);
+    }
+
+    hasPhases = true;
+
+    // The first hop of the overlap-add is finished; the stream takes whatever it hasn't got yet
+    const int alreadyHave = numReady - accumStart;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto& channel = channels[(size_t)ch];
+
+        if (alreadyHave < hopSize)
+            juce::FloatVectorOperations::multiply(channel.stream.data() + numReady, channel.overlapAdd.data() + alreadyHave,
+                                                  engine.outputGain, hopSize - alreadyHave);
+
+        std::memmove(channel.overlapAdd.data(), channel.overlapAdd.data() + hopSize, sizeof(float) * (size_t)(fftSize - hopSize));
+        juce::FloatVectorOperations::clear(channel.overlapAdd.data() + (fftSize - hopSize), hopSize);
+    }
+
+    if (alreadyHave < hopSize)
+        numReady += hopSize - alreadyHave;
+
+    accumStart += hopSize;
+}
+
+void ForgeStretcher::lockPhases(Channel& channel) noexcept
+{
+    auto& synthesis = channel.synthesisPhase;
+    const float* m = magnitude.data();
+
+    if (!hasPhases)
+    {
+        std::copy(phase.begin(), phase.end(), synthesis.begin());
+        return;
+    }
+
+    int numPeaks = 0;
+    for (int k = 2; k < numBins - 2; ++k)
+        if (m[k] > m[k - 1] && m[k] >= m[k + 1] && m[k] > m[k - 2] && m[k] >= m[k + 2])
+            peaks[(size_t)numPeaks++] = k;
+
+    // No structure to lock to: every bin advances on its own
+    if (numPeaks == 0)
+    {
+        for (int k = 0; k < numBins; ++k)
+            synthesis[(size_t)k] = SpectralKernels::wrapPhase(synthesis[(size_t)k] + phase[(size_t)k] - earlierPhase[(size_t)k]);
+        return;
+    }
+
+    // Each peak's region runs to the quietest bin before the next peak. The peak turns by its own
+    // measured advance; the rest of the region keeps its analysed offset from the peak.
+    int regionStart = 0;
+    for (int i = 0; i < numPeaks; ++i)
+    {
+        const int p = peaks[(size_t)i];
+        int regionEnd = numBins;
+
+        if (i + 1 < numPeaks)
+        {
+            regionEnd = p + 1;
+            for (int k = p + 1; k < peaks[(size_t)i + 1]; ++k)
+                if (m[k] < m[regionEnd])
+                    regionEnd = k;
+        }
+
+        const float peakPhase = SpectralKernels::wrapPhase(synthesis[(size_t)p] + phase[(size_t)p] - earlierPhase[(size_t)p]);
+        const float offset = peakPhase - phase[(size_t)p];
+
+        for (int k = regionStart; k < regionEnd; ++k)
+            synthesis[(size_t)k] = SpectralKernels::wrapPhase(phase[(size_t)k] + offset);
+
+        regionStart = regionEnd;
+    }
+}
@@ -0,0 +1,75 @@
+// Core/ForgeStretcher.h
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+#include "SampleStorage.h"
+
+//==============================================================================
+// Phase-locked vocoder time-stretch for one ForgeVoice.
+//
+// Frames are read straight from the sample around wherever the playhead will
+// be, so nothing is buffered ahead of the output and the stretch adds no
+// latency; a change of rate is heard from the next hop. Each frame takes its
+// phase advance from a second analysis one hop earlier in the source, and
+// bins around each spectral peak keep their phase relative to it (identity
+// phase locking), which holds transients and partials together.
+//
+// The vocoder stretches by rate / pitch and its output is resampled by pitch,
+// so tempo and pitch are independent. The FFT and window are shared by every
+// stretcher; all per-voice frames are allocated in prepare().
+class ForgeStretcher
+{
+public:
+    static constexpr int fftOrder = 11;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int overlap = 4;
+    static constexpr int hopSize = fftSize / overlap;
+    static constexpr int numBins = fftSize / 2 + 1;
+    static constexpr int maxChunk = 256;          // output samples per render() call
+    static constexpr float maxPitch = 4.0f;
+
+    ForgeStretcher() = default;
+
+    void prepare();   // not on the audio thread
+    void reset();     // the next render() starts afresh wherever the playhead is
+
+    // Renders numSamples (up to maxChunk) of the source into dest's first numChannels channels.
+    // position is the playhead at the first sample; it moves rate source samples per output sample.
+    void render(const SampleStorage& source, double position, double rate, float pitch,
+                juce::AudioBuffer<float>& dest, int numChannels, int numSamples) noexcept;
+
+private:
+    struct Channel
+    {
+        std::vector<float> overlapAdd;       // fftSize, starting at stream index accumStart
+        std::vector<float> stream;           // finished vocoder output, read at the pitch step
+        std::vector<float> synthesisPhase;   // last frame's output phase per bin
+    };
+
+    void addFrame(const SampleStorage& source, int numChannels, double centre) noexcept;
+    void lockPhases(Channel& channel) noexcept;
+
+    static constexpr int streamCapacity = (int)(maxChunk * maxPitch) + hopSize + 8;
+
+    std::vector<Channel> channels;
+
+    // Per-frame scratch
+    std::vector<float> frame, earlier;                    // 2 * fftSize each
+    std::vector<float> magnitude, phase;                  // numBins each
+    std::vector<float> earlierMagnitude, earlierPhase;
+    std::vector<int>   peaks;
+
+    // Stream read positions for the resampler
+    std::vector<int>   readIndex;
+    std::vector<float> readFrac;
+
+    // Stream bookkeeping: stream index 0 is the oldest sample kept
+    double readPos = 1.0;         // the next output sample's stream position
+    int    numReady = 1;          // finished stream samples
+    int    accumStart = 1;        // stream index of overlapAdd[0]; below numReady while priming
+    bool   hasPhases = false;     // synthesisPhase carries on from a previous frame
+    double expectedPosition = -1.0;   // where the last render() left the playhead, -1 after reset()
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ForgeStretcher)
+};
@@ -1,149 +1,379 @@
-// Core/ForgeVoice.cpp
-#include "ForgeVoice.h"
-
-void ForgeVoice::prepare(double sr, int blockSize)
-{
-    sampleRate = sr;
-    processBuffer.setSize(2, blockSize);
-
-    // Initialize DSP
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sr;
-    spec.maximumBlockSize = static_cast<juce::uint32>(blockSize);
-    spec.numChannels = 2;
-
-    oversampling.initProcessing(static_cast<size_t>(blockSize));
-    oversampling.reset();
-
-    pitchSmooth.reset(sr, 0.02); // 20ms smoothing
-    volumeSmooth.reset(sr, 0.01); // 10ms smoothing
-}
-
-void ForgeVoice::setSample(juce::AudioBuffer<float>&& newBuffer, double originalBPM)
-{
-    buffer = std::move(newBuffer);
-    this->originalBPM = originalBPM;
-    sampleName = "Sample " + juce::String(juce::Random::getSystemRandom().nextInt(1000));
-    reset();
-}
-
-void ForgeVoice::process(juce::AudioBuffer<float>& output, int startSample, int numSamples)
-{
-    if (!isPlaying || buffer.getNumSamples() == 0)
-        return;
-
-    processBuffer.clear();
-
-    // Update smoothed values
-    pitchSmooth.setTargetValue(pitch);
-    volumeSmooth.setTargetValue(volume);
-
-    const int numChannels = juce::jmin(output.getNumChannels(), buffer.getNumChannels());
-
-    for (int sample = 0; sample < numSamples; ++sample)
-    {
-        // Update playback rate for this sample
-        updatePlaybackRate();
-
-        // Get interpolated sample
-        const int pos = static_cast<int>(position);
-        const float frac = static_cast<float>(position - pos);
-
-        for (int ch = 0; ch < numChannels; ++ch)
-        {
-            if (pos < buffer.getNumSamples() - 1)
-            {
-                const float* channelData = buffer.getReadPointer(ch % buffer.getNumChannels());
-                float sampleValue = channelData[pos] * (1.0f - frac) + channelData[pos + 1] * frac;
-
-                // Apply processing
-                sampleValue = processSample(sampleValue);
-
-                // Apply volume with smoothing
-                sampleValue *= volumeSmooth.getNextValue();
-
-                // Write to output
-                output.addSample(ch, startSample + sample, sampleValue);
-            }
-        }
-
-        // Advance position
-        position += playbackRate * pitchSmooth.getNextValue();
-
-        // Handle loop/stop
-        if (position >= buffer.getNumSamples())
-        {
-            position = 0.0;
-            // For now, just loop. Later we can add one-shot mode
-        }
-    }
-}
-
-void ForgeVoice::start()
-{
-    isPlaying = true;
-}
-
-void ForgeVoice::stop()
-{
-    isPlaying = false;
-}
-
-void ForgeVoice::reset()
-{
-    position = 0.0;
-    updatePlaybackRate();
-}
-
-void ForgeVoice::setPitch(float semitones)
-{
-    pitch = std::pow(2.0f, semitones / 12.0f);
-}
-
-void ForgeVoice::setSpeed(float spd)
-{
-    speed = juce::jlimit(0.1f, 4.0f, spd);
-    updatePlaybackRate();
-}
-
-void ForgeVoice::setSyncMode(bool sync)
-{
-    syncEnabled = sync;
-    updatePlaybackRate();
-}
-
-void ForgeVoice::setHostBPM(double bpm)
-{
-    hostBPM = bpm;
-    updatePlaybackRate();
-}
-
-void ForgeVoice::updatePlaybackRate()
-{
-    playbackRate = speed;
-
-    if (syncEnabled && hostBPM > 0 && originalBPM > 0)
-    {
-        playbackRate *= (hostBPM / originalBPM);
-    }
-}
-
-float ForgeVoice::processSample(float input)
-{
-    float output = input;
-
-    // Apply drive (simple tanh distortion)
-    if (drive > 1.0f)
-    {
-        output = std::tanh(output * drive) / drive;
-    }
-
-    // Apply bit crushing
-    if (crushBits < 16.0f)
-    {
-        const float scale = std::pow(2.0f, crushBits - 1.0f);
-        output = std::round(output * scale) / scale;
-    }
-
-    return output;
-}
\ No newline at end of file
+// Core/ForgeVoice.cpp
+#include "ForgeVoice.h"
+
+void ForgeVoice::prepare(double sr, int blockSize)
+{
+    sampleRate = sr;
+
+    // Room for a full block at up to 4x playback rate plus the widest interpolator
+    // reach; faster playback is simply split into more chunks.
+    processBuffer.setSize(2, blockSize * 4 + 2 + maxInterpolationReach);
+    ForgeKernels::prepareTables();
+
+    // Per-block render scratch
+    voiceBuffer.setSize(2, blockSize);
+    dryBuffer.setSize(2, blockSize);
+    readIndex.resize(static_cast<size_t>(blockSize));
+    readFrac.resize(static_cast<size_t>(blockSize));
+    gainRamp.resize(static_cast<size_t>(blockSize));
+    stretcher.prepare();
+    psola.prepare();
+
+    // Initialize DSP
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = sr;
+    spec.maximumBlockSize = static_cast<juce::uint32>(blockSize);
+    spec.numChannels = 2;
+
+    oversampling.initProcessing(static_cast<size_t>(blockSize));
+    oversampling.reset();
+
+    pitchSmooth.reset(sr, 0.02); // 20ms smoothing
+    volumeSmooth.reset(sr, 0.01); // 10ms smoothing
+    pitchSmooth.setCurrentAndTargetValue(pitch);
+    volumeSmooth.setCurrentAndTargetValue(volume);
+    nonlinearMix.reset(sr, nonlinearFadeSeconds);
+    nonlinearMix.setCurrentAndTargetValue(isClean() ? 0.0f : 1.0f);
+}
+
+void ForgeVoice::setSample(juce::AudioBuffer<float>&& newBuffer, double originalBPM,
+                           SampleStorage::Format storageFormat)
+{
+    storage.setFrom(newBuffer, storageFormat);
+    newBuffer.setSize(0, 0);
+    this->originalBPM = originalBPM;
+    sampleName = "Sample " + juce::String(juce::Random::getSystemRandom().nextInt(1000));
+    reset();
+}
+
+void ForgeVoice::swapSample(SampleStorage& newStorage, juce::String& newName, double originalBPM)
+{
+    std::swap(storage, newStorage);
+    sampleName.swapWith(newName);
+    this->originalBPM = originalBPM;
+    reset();
+}
+
+void ForgeVoice::overwriteSample(int startSample, const juce::AudioBuffer<float>& audio)
+{
+    const int num = juce::jmin(audio.getNumSamples(), storage.getNumSamples() - startSample);
+    if (startSample < 0 || num <= 0)
+        return;
+
+    for (int ch = 0; ch < juce::jmin(audio.getNumChannels(), storage.getNumChannels()); ++ch)
+        storage.writeRange(ch, startSample, audio.getReadPointer(ch), num);
+}
+
+void ForgeVoice::replaceStorage(SampleStorage& newStorage)
+{
+    jassert(newStorage.getNumChannels() == storage.getNumChannels()
+            && newStorage.getNumSamples() == storage.getNumSamples());
+
+    // Notes borrowing this voice's sample hold a pointer to storage itself, so they follow the swap
+    std::swap(storage, newStorage);
+}
+
+void ForgeVoice::process(juce::AudioBuffer<float>& output, int startSample, int numSamples)
+{
+    const int maxChunk = voiceBuffer.getNumSamples();
+    const auto& source = getSource();
+    if (!isPlaying || source.isEmpty() || maxChunk == 0)
+        return;
+
+    // Update smoothed values
+    pitchSmooth.setTargetValue(pitch);
+    volumeSmooth.setTargetValue(volume);
+
+    const int sourceChannels = juce::jmin(source.getNumChannels(), voiceBuffer.getNumChannels());
+    const int sourceLength = source.getNumSamples();
+    const int windowCapacity = processBuffer.getNumSamples();
+    const auto reach = ForgeKernels::getReach(interpolation);
+    const int windowGuard = reach.before + reach.after + 1;
+
+    int done = 0;
+    while (done < numSamples)
+    {
+        int chunk;
+        double nextPosition;
+
+        if (isStretching())
+        {
+            // 1-2. The stretcher follows the playhead at playbackRate and applies the pitch itself
+            chunk = juce::jmin(numSamples - done, maxChunk, ForgeStretcher::maxChunk, ForgePsola::maxChunk);
+
+            if (stretchMode == StretchMode::Psola)
+                psola.render(source, position, playbackRate, pitchSmooth.getCurrentValue(),
+                             voiceBuffer, sourceChannels, chunk);
+            else
+                stretcher.render(source, position, playbackRate, pitchSmooth.getCurrentValue(),
+                                 voiceBuffer, sourceChannels, chunk);
+            pitchSmooth.skip(chunk);
+            nextPosition = position + playbackRate * chunk;
+        }
+        else
+        {
+            // 1. Playhead: read positions for the whole chunk, relative to the window start.
+            //    The chunk is cut short when the playhead could outrun the decode window.
+            const double maxStep = playbackRate * juce::jmax(pitchSmooth.getCurrentValue(), pitchSmooth.getTargetValue());
+            chunk = juce::jlimit(1, juce::jmin(numSamples - done, maxChunk),
+                                 static_cast<int>((windowCapacity - windowGuard) / juce::jmax(maxStep, 1.0e-6)));
+            const int windowStart = static_cast<int>(position);
+            double localPos = position - windowStart;
+
+            if (pitchSmooth.isSmoothing())
+            {
+                for (int i = 0; i < chunk; ++i)
+                {
+                    const int idx = static_cast<int>(localPos);
+                    readIndex[(size_t)i] = idx;
+                    readFrac[(size_t)i] = static_cast<float>(localPos - idx);
+                    localPos += playbackRate * pitchSmooth.getNextValue();
+                }
+            }
+            else
+            {
+                const double step = playbackRate * pitchSmooth.getTargetValue();
+                for (int i = 0; i < chunk; ++i)
+                {
+                    const double p = localPos + step * i;
+                    const int idx = static_cast<int>(p);
+                    readIndex[(size_t)i] = idx;
+                    readFrac[(size_t)i] = static_cast<float>(p - idx);
+                }
+                localPos += step * chunk;
+            }
+
+            // 2. Decode the reachable window (wrapping at the loop point) and interpolate
+            const int windowLength = readIndex[(size_t)chunk - 1] + windowGuard;
+
+            for (int ch = 0; ch < sourceChannels; ++ch)
+            {
+                float* window = processBuffer.getWritePointer(ch);
+                float* voiceData = voiceBuffer.getWritePointer(ch);
+
+                source.readWindow(ch, windowStart - reach.before, windowLength, window);
+                window += reach.before;
+
+                switch (interpolation)
+                {
+                case Interpolation::Linear:
+                    ForgeKernels::interpolateLinear(window, readIndex.data(), readFrac.data(), voiceData, chunk);
+                    break;
+                case Interpolation::Hermite:
+                    ForgeKernels::interpolateHermite(window, readIndex.data(), readFrac.data(), voiceData, chunk);
+                    break;
+                case Interpolation::Sinc:
+                    ForgeKernels::interpolateSinc(window, readIndex.data(), readFrac.data(), voiceData, chunk, maxStep);
+                    break;
+                }
+            }
+
+            nextPosition = windowStart + localPos;
+        }
+
+        // 3. Drive / crush
+        processNonlinear(sourceChannels, chunk);
+
+        // Level meter peak, taken at the louder end of this chunk's gain
+        const float meterGain = juce::jmax(volumeSmooth.getCurrentValue(), volumeSmooth.getTargetValue());
+        for (int ch = 0; ch < sourceChannels; ++ch)
+        {
+            const auto range = juce::FloatVectorOperations::findMinAndMax(voiceBuffer.getReadPointer(ch), chunk);
+            peakLevel = juce::jmax(peakLevel, meterGain * juce::jmax(-range.getStart(), range.getEnd()));
+        }
+
+        // 4. Volume, one smoother step per output sample shared by every channel.
+        //    Mono sources feed every output channel.
+        if (volumeSmooth.isSmoothing())
+        {
+            for (int i = 0; i < chunk; ++i)
+                gainRamp[(size_t)i] = volumeSmooth.getNextValue();
+
+            for (int ch = 0; ch < output.getNumChannels(); ++ch)
+                juce::FloatVectorOperations::addWithMultiply(output.getWritePointer(ch, startSample + done),
+                                                             voiceBuffer.getReadPointer(ch % sourceChannels),
+                                                             gainRamp.data(), chunk);
+        }
+        else
+        {
+            const float gain = volumeSmooth.getTargetValue();
+            for (int ch = 0; ch < output.getNumChannels(); ++ch)
+                juce::FloatVectorOperations::addWithMultiply(output.getWritePointer(ch, startSample + done),
+                                                             voiceBuffer.getReadPointer(ch % sourceChannels),
+                                                             gain, chunk);
+        }
+
+        // 5. Advance, looping seamlessly at the end of the sample
+        position = nextPosition;
+        if (position >= sourceLength)
+            position = std::fmod(position, static_cast<double>(sourceLength));
+
+        done += chunk;
+    }
+
+    finishRelease();
+}
+
+void ForgeVoice::start()
+{
+    isPlaying = true;
+}
+
+void ForgeVoice::stop()
+{
+    isPlaying = false;
+}
+
+void ForgeVoice::startNote(const ForgeVoice& slot, float pitchRatio, float gain)
+{
+    borrowedStorage = &slot.getSource();
+    position = 0.0;
+    isPlaying = true;
+    releasing = false;
+    peakLevel = 0.0f;
+    nonlinearEngaged = false;
+    stretcher.reset();
+    psola.reset();
+
+    followSlot(slot, pitchRatio, gain);
+
+    // A new note starts at its own pitch, level and drive rather than gliding from the last one
+    pitchSmooth.setCurrentAndTargetValue(pitch);
+    volumeSmooth.setCurrentAndTargetValue(volume);
+    nonlinearMix.setCurrentAndTargetValue(isClean() ? 0.0f : 1.0f);
+}
+
+void ForgeVoice::followSlot(const ForgeVoice& slot, float pitchRatio, float gain)
+{
+    speed = slot.speed;
+    syncEnabled = slot.syncEnabled;
+    hostBPM = slot.hostBPM;
+    originalBPM = slot.originalBPM;
+    drive = slot.drive;
+    crushBits = slot.crushBits;
+    interpolation = slot.interpolation;
+    stretchMode = slot.stretchMode;
+    pitch = slot.pitch * pitchRatio;
+    updatePlaybackRate();
+
+    if (!releasing)
+        volume = slot.volume * gain;
+}
+
+void ForgeVoice::releaseNote()
+{
+    releasing = true;
+    volume = 0.0f;
+}
+
+void ForgeVoice::killNote()
+{
+    isPlaying = false;
+    releasing = false;
+    borrowedStorage = nullptr;
+}
+
+void ForgeVoice::finishRelease()
+{
+    if (releasing && volumeSmooth.getCurrentValue() <= 0.0f && !volumeSmooth.isSmoothing())
+        killNote();
+}
+
+void ForgeVoice::reset()
+{
+    position = 0.0;
+    updatePlaybackRate();
+}
+
+void ForgeVoice::setPitch(float semitones)
+{
+    pitch = std::pow(2.0f, semitones / 12.0f);
+}
+
+void ForgeVoice::setSpeed(float spd)
+{
+    speed = juce::jlimit(0.1f, 4.0f, spd);
+    updatePlaybackRate();
+}
+
+void ForgeVoice::setSyncMode(bool sync)
+{
+    syncEnabled = sync;
+    updatePlaybackRate();
+}
+
+void ForgeVoice::setHostBPM(double bpm)
+{
+    hostBPM = bpm;
+    updatePlaybackRate();
+}
+
+void ForgeVoice::updatePlaybackRate()
+{
+    playbackRate = speed;
+
+    if (syncEnabled && hostBPM > 0 && originalBPM > 0)
+    {
+        playbackRate *= (hostBPM / originalBPM);
+    }
+}
+
+void ForgeVoice::processNonlinear(int numChannels, int numSamples)
+{
+    if (!isClean())
+    {
+        fadeDrive = drive;
+        fadeCrushBits = crushBits;
+    }
+    nonlinearMix.setTargetValue(isClean() ? 0.0f : 1.0f);
+
+    // Clean and done fading out
+    if (!nonlinearMix.isSmoothing() && nonlinearMix.getTargetValue() == 0.0f)
+    {
+        nonlinearEngaged = false;
+        return;
+    }
+
+    // Coming out of bypass: the filters still hold audio from the last time.
+    // The fade in starts from dry, so their start-up is masked.
+    if (!nonlinearEngaged)
+    {
+        oversampling.reset();
+        nonlinearEngaged = true;
+    }
+
+    const bool fading = nonlinearMix.isSmoothing();
+    if (fading)
+        for (int ch = 0; ch < numChannels; ++ch)
+            dryBuffer.copyFrom(ch, 0, voiceBuffer, ch, 0, numSamples);
+
+    juce::dsp::AudioBlock<float> block(voiceBuffer.getArrayOfWritePointers(),
+                                       static_cast<size_t>(numChannels),
+                                       static_cast<size_t>(numSamples));
+    auto upsampled = oversampling.processSamplesUp(block);
+
+    for (size_t ch = 0; ch < upsampled.getNumChannels(); ++ch)
+    {
+        float* data = upsampled.getChannelPointer(ch);
+        const int num = static_cast<int>(upsampled.getNumSamples());
+
+        ForgeKernels::applyDrive(data, num, fadeDrive);
+        ForgeKernels::applyCrush(data, num, fadeCrushBits);
+    }
+
+    oversampling.processSamplesDown(block);
+
+    if (!fading)
+        return;
+
+    // wet = dry + mix * (wet - dry), one smoother step per sample shared by every channel
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float mix = nonlinearMix.getNextValue();
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const float dry = dryBuffer.getSample(ch, i);
+            voiceBuffer.setSample(ch, i, dry + mix * (voiceBuffer.getSample(ch, i) - dry));
+        }
+    }
+}
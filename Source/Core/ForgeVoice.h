@@ -1,75 +1,146 @@
-#pragma once
-
-#include <juce_core/juce_core.h>
-#include <juce_audio_basics/juce_audio_basics.h>
-#include <juce_audio_formats/juce_audio_formats.h>
-#include <juce_audio_processors/juce_audio_processors.h>
-#include <juce_gui_basics/juce_gui_basics.h>
-#include <juce_dsp/juce_dsp.h>
-
-class ForgeVoice
-{
-public:
-    ForgeVoice() = default;
-
-    void prepare(double sampleRate, int blockSize);
-    void setSample(juce::AudioBuffer<float>&& newBuffer, double originalBPM = 120.0);
-    void process(juce::AudioBuffer<float>& output, int startSample, int numSamples);
-
-    // Control
-    void start();
-    void stop();
-    void reset();
-    bool isActive() const { return isPlaying; }
-
-    // Parameters
-    void setPitch(float semitones);
-    void setSpeed(float speed);
-    void setSyncMode(bool sync);
-    void setHostBPM(double bpm);
-    void setVolume(float vol) { volume = vol; }
-    void setDrive(float drv) { drive = juce::jlimit(1.0f, 10.0f, drv); }
-    void setCrush(float bits) { crushBits = juce::jlimit(1.0f, 16.0f, bits); }
-
-    // Info
-    juce::String getSampleName() const { return sampleName; }
-    bool hasSample() const { return buffer.getNumSamples() > 0; }
-    float getProgress() const { return buffer.getNumSamples() > 0 ? position / (double)buffer.getNumSamples() : 0.0f; }
-
-private:
-    // Audio data
-    juce::AudioBuffer<float> buffer;
-    juce::AudioBuffer<float> processBuffer;
-    juce::String sampleName;
-
-    // Playback state
-    double position = 0.0;
-    double playbackRate = 1.0;
-    bool isPlaying = false;
-
-    // Parameters
-    float volume = 0.7f;
-    float pitch = 0.0f;      // in semitones
-    float speed = 1.0f;      // playback speed multiplier
-    float drive = 1.0f;      // distortion amount
-    float crushBits = 16.0f; // bit crushing
-
-    // Sync
-    bool syncEnabled = false;
-    double hostBPM = 120.0;
-    double originalBPM = 120.0;
-    double sampleRate = 44100.0;
-
-    // DSP
-    juce::dsp::Oversampling<float> oversampling{ 2, 2, juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR };
-    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> pitchSmooth;
-    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> volumeSmooth;
-
-    // Helpers
-    void updatePlaybackRate();
-    float processSample(float input);
-    // Disallow copying and assignment:
-    ForgeVoice(const ForgeVoice&) = delete;
-    ForgeVoice& operator= (const ForgeVoice&) = delete;
-
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <juce_dsp/juce_dsp.h>
+#include "SampleStorage.h"
+#include "ForgeKernels.h"
+#include "ForgeStretcher.h"
+#include "ForgePsola.h"
+#include <vector>
+
+class ForgeVoice
+{
+public:
+    using Interpolation = ForgeKernels::Interpolation;
+
+    // How speed, sync and pitch move the sound. Resample is the cheapest and couples
+    // pitch to tempo; the other two keep the playhead on the host grid and transpose on top.
+    enum class StretchMode
+    {
+        Resample = 0,   // read faster or slower; pitch follows tempo
+        PhaseVocoder,   // ForgeStretcher; any material, heaviest
+        Psola           // ForgePsola; monophonic material, light
+    };
+
+    ForgeVoice() = default;
+
+    void prepare(double sampleRate, int blockSize);
+    void setSample(juce::AudioBuffer<float>&& newBuffer, double originalBPM = 120.0,
+                   SampleStorage::Format storageFormat = SampleStorage::Format::Float32);
+    // Takes over already-encoded sample memory; the old sample goes back in its place
+    void swapSample(SampleStorage& newStorage, juce::String& newName, double originalBPM);
+    // Overwrites part of the sample in place, encoded to its format; notes playing it hear the change
+    void overwriteSample(int startSample, const juce::AudioBuffer<float>& audio);
+    // Takes over the same audio in another format and keeps playing; the old memory goes back in its place
+    void replaceStorage(SampleStorage& newStorage);
+    void process(juce::AudioBuffer<float>& output, int startSample, int numSamples);
+
+    // Control
+    void start();
+    void stop();
+    void reset();
+    bool isActive() const { return isPlaying; }
+
+    // Note playback from the voice pool: plays another voice's sample with its settings
+    void startNote(const ForgeVoice& slot, float pitchRatio, float gain);
+    void followSlot(const ForgeVoice& slot, float pitchRatio, float gain);
+    void releaseNote();     // fades out over the volume smoothing time, then stops
+    void killNote();
+    bool isReleasing() const { return releasing; }
+    float getCurrentGain() const { return volumeSmooth.getCurrentValue(); }
+
+    // Parameters
+    void setPitch(float semitones);     // also changes speed in StretchMode::Resample
+    void setSpeed(float speed);
+    void setSyncMode(bool sync);
+    void setHostBPM(double bpm);
+    void setVolume(float vol) { volume = vol; }
+    void setDrive(float drv) { drive = juce::jlimit(1.0f, 10.0f, drv); }
+    void setCrush(float bits) { crushBits = juce::jlimit(1.0f, 16.0f, bits); }
+    void setInterpolation(Interpolation type) { interpolation = type; }
+    Interpolation getInterpolation() const { return interpolation; }
+    void setStretchMode(StretchMode mode) { stretchMode = mode; }
+    StretchMode getStretchMode() const { return stretchMode; }
+
+    // Info
+    juce::String getSampleName() const { return sampleName; }
+    bool hasSample() const { return !getSource().isEmpty(); }
+    float getProgress() const { return hasSample() ? position / (double)getSource().getNumSamples() : 0.0f; }
+    SampleStorage::Format getStorageFormat() const { return storage.getFormat(); }
+    size_t getSampleMemoryBytes() const { return storage.getMemoryBytes(); }
+    size_t getSampleMemorySaved() const { return storage.getMemorySavedBytes(); }
+    // Loudest output sample since the last call; audio thread
+    float takePeakLevel() { const float p = peakLevel; peakLevel = 0.0f; return p; }
+
+private:
+    // Audio data
+    SampleStorage storage;
+    const SampleStorage* borrowedStorage = nullptr;  // another voice's sample while playing a note
+    juce::AudioBuffer<float> processBuffer;  // decoded read window, one chunk at a time
+
+    // Block render scratch, sized in prepare()
+    juce::AudioBuffer<float> voiceBuffer;
+    std::vector<int>         readIndex;
+    std::vector<float>       readFrac;
+    std::vector<float>       gainRamp;
+    juce::String sampleName;
+
+    // Playback state
+    double position = 0.0;
+    double playbackRate = 1.0;
+    bool isPlaying = false;
+    bool releasing = false;
+    float peakLevel = 0.0f;
+
+    // Parameters
+    float volume = 0.7f;
+    float pitch = 1.0f;      // pitch ratio, set in semitones
+    float speed = 1.0f;      // playback speed multiplier
+    float drive = 1.0f;      // distortion amount
+    float crushBits = 16.0f; // bit crushing
+    Interpolation interpolation = Interpolation::Linear;
+    StretchMode stretchMode = StretchMode::Resample;
+
+    // Sync
+    bool syncEnabled = false;
+    double hostBPM = 120.0;
+    double originalBPM = 120.0;
+    double sampleRate = 44100.0;
+
+    // DSP
+    // 4x oversampling around the drive/crush stage; bypassed while the voice is clean.
+    // Crossing the clean threshold crossfades between dry and processed, with the
+    // oversampler still running until the fade out is done.
+    juce::dsp::Oversampling<float> oversampling{ 2, 2, juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR };
+    bool nonlinearEngaged = false;
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> nonlinearMix;   // 0 = dry, 1 = processed
+    float fadeDrive = 1.0f;       // the last drive/crush that wasn't clean, which a fade out keeps using
+    float fadeCrushBits = 16.0f;
+    juce::AudioBuffer<float> dryBuffer;   // voiceBuffer before drive/crush, while fading
+    static constexpr double nonlinearFadeSeconds = 0.005;
+    ForgeStretcher stretcher;
+    ForgePsola psola;
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> pitchSmooth;
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> volumeSmooth;
+
+    static constexpr int maxInterpolationReach = 16;
+
+    // Helpers
+    const SampleStorage& getSource() const { return borrowedStorage != nullptr ? *borrowedStorage : storage; }
+    void updatePlaybackRate();
+    void finishRelease();
+    bool isClean() const { return drive <= 1.0f && crushBits >= 16.0f; }
+    bool isStretching() const { return stretchMode != StretchMode::Resample; }
+    void processNonlinear(int numChannels, int numSamples);
+    // The lane renderer drives this voice's playhead and smoothers directly
+    friend class ForgeLaneRenderer;
+
+    // Disallow copying and assignment:
+    ForgeVoice(const ForgeVoice&) = delete;
+    ForgeVoice& operator= (const ForgeVoice&) = delete;
+
 };
\ No newline at end of file
@@ -0,0 +1,198 @@
+#include "ForgeVoice.h"
+#include "ForgeLaneRenderer.h"
+#include <JuceHeader.h>
+
+/**
+ * Per-voice render throughput for ForgeVoice
+ * Run during development to spot regressions in the block kernel
+ */
+class ForgeVoiceBenchmark
+{
+public:
+    static bool runBenchmarks()
+    {
+        DBG("=== ForgeVoice Benchmarks ===");
+
+        for (const auto type : { ForgeVoice::Interpolation::Linear,
+                                 ForgeVoice::Interpolation::Hermite,
+                                 ForgeVoice::Interpolation::Sinc })
+        {
+            DBG(getInterpolationName(type) << " interpolation:");
+
+            for (const float rate : { 1.0f, 0.5f, 2.0f })
+            {
+                if (!benchmarkRate(rate, type))
+                    return false;
+            }
+        }
+
+        DBG("Eight slots, per voice vs lanes:");
+        for (const auto type : { ForgeVoice::Interpolation::Linear,
+                                 ForgeVoice::Interpolation::Hermite })
+        {
+            if (!benchmarkLanes(type))
+                return false;
+        }
+
+        DBG("=== ForgeVoice benchmarks complete ===");
+        return true;
+    }
+
+private:
+    static constexpr double benchSampleRate = 48000.0;
+    static constexpr int benchBlockSize = 512;
+    static constexpr int benchBlocks = 2000;
+    static constexpr int equivalenceBlocks = 20;
+    static constexpr float laneTolerance = 1.0e-5f;   // eight slots summed in a different order
+
+    static juce::AudioBuffer<float> makeTestSample()
+    {
+        // 10 seconds of stereo noise - long enough that reads never stay in L1
+        juce::AudioBuffer<float> sample(2, static_cast<int>(benchSampleRate * 10.0));
+        juce::Random random(1234);
+
+        for (int ch = 0; ch < sample.getNumChannels(); ++ch)
+        {
+            auto* data = sample.getWritePointer(ch);
+            for (int i = 0; i < sample.getNumSamples(); ++i)
+                data[i] = random.nextFloat() * 2.0f - 1.0f;
+        }
+
+        return sample;
+    }
+
+    static juce::String getInterpolationName(ForgeVoice::Interpolation type)
+    {
+        switch (type)
+        {
+        case ForgeVoice::Interpolation::Linear:  return "Linear";
+        case ForgeVoice::Interpolation::Hermite: return "Hermite";
+        case ForgeVoice::Interpolation::Sinc:    return "Sinc";
+        }
+        return {};
+    }
+
+    static bool benchmarkRate(float rate, ForgeVoice::Interpolation type)
+    {
+        ForgeVoice voice;
+        voice.prepare(benchSampleRate, benchBlockSize);
+        voice.setSample(makeTestSample());
+        voice.setInterpolation(type);
+        voice.setSpeed(rate);
+        voice.start();
+
+        juce::AudioBuffer<float> output(2, benchBlockSize);
+
+        // Warm up caches and smoothers
+        for (int i = 0; i < 50; ++i)
+            voice.process(output, 0, benchBlockSize);
+
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+
+        for (int i = 0; i < benchBlocks; ++i)
+        {
+            output.clear();
+            voice.process(output, 0, benchBlockSize);
+        }
+
+        const double seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+        const double samplesPerSecond = (double)benchBlocks * benchBlockSize / seconds;
+
+        for (int ch = 0; ch < output.getNumChannels(); ++ch)
+        {
+            for (int i = 0; i < benchBlockSize; ++i)
+            {
+                if (!std::isfinite(output.getSample(ch, i)))
+                {
+                    DBG("FAIL: Voice produced invalid output at rate " << rate);
+                    return false;
+                }
+            }
+        }
+
+        DBG("  rate " << rate << "x: " << juce::String(samplesPerSecond / 1.0e6, 2) << " Msamples/s, "
+            << juce::String(samplesPerSecond / benchSampleRate, 0) << "x realtime at 48 kHz");
+        return true;
+    }
+
+    static bool benchmarkLanes(ForgeVoice::Interpolation type)
+    {
+        // Two identical sets: one renders voice by voice, the other through the lanes
+        std::array<ForgeVoice, ForgeLaneRenderer::numLanes> voices, laneVoices;
+        ForgeLaneRenderer lanes;
+        lanes.prepare(benchSampleRate, benchBlockSize);
+
+        const auto testSample = makeTestSample();
+        for (auto* set : { &voices, &laneVoices })
+        {
+            for (int i = 0; i < (int)set->size(); ++i)
+            {
+                auto& v = (*set)[(size_t)i];
+                v.prepare(benchSampleRate, benchBlockSize);
+                v.setSample(juce::AudioBuffer<float>(testSample));
+                v.setInterpolation(type);
+                v.setSpeed(0.5f + 0.25f * (float)i);
+                v.start();
+            }
+        }
+
+        juce::AudioBuffer<float> output(2, benchBlockSize);
+        juce::AudioBuffer<float> expected(2, benchBlockSize);
+
+        // Both paths from the same state must agree before either is timed
+        for (int block = 0; block < equivalenceBlocks; ++block)
+        {
+            expected.clear();
+            output.clear();
+
+            for (auto& v : voices)
+                v.process(expected, 0, benchBlockSize);
+            lanes.process(laneVoices, output, 0, benchBlockSize);
+
+            for (int ch = 0; ch < output.getNumChannels(); ++ch)
+            {
+                for (int i = 0; i < benchBlockSize; ++i)
+                {
+                    const float difference = std::abs(output.getSample(ch, i) - expected.getSample(ch, i));
+                    if (!(difference <= laneTolerance))
+                    {
+                        DBG("FAIL: Lanes differ from per-voice rendering by " << difference
+                            << " at block " << block << ", channel " << ch << ", sample " << i);
+                        return false;
+                    }
+                }
+            }
+        }
+
+        const auto timeBlocks = [&](auto&& render)
+        {
+            for (int i = 0; i < 50; ++i)
+                render();
+
+            const auto startTicks = juce::Time::getHighResolutionTicks();
+            for (int i = 0; i < benchBlocks; ++i)
+            {
+                output.clear();
+                render();
+            }
+            return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+        };
+
+        const double perVoiceSeconds = timeBlocks([&] {
+            for (auto& v : voices)
+                v.process(output, 0, benchBlockSize);
+        });
+        const double laneSeconds = timeBlocks([&] { lanes.process(laneVoices, output, 0, benchBlockSize); });
+
+        DBG("  " << getInterpolationName(type) << ": per voice " << juce::String(perVoiceSeconds * 1000.0, 1)
+            << " ms, lanes " << juce::String(laneSeconds * 1000.0, 1) << " ms ("
+            << juce::String(perVoiceSeconds / laneSeconds, 2) << "x)");
+        return true;
+    }
+};
+
+// Function to run benchmarks (can be called from main application during development)
+bool benchmarkForgeVoice()
+{
+    return ForgeVoiceBenchmark::runBenchmarks();
+}
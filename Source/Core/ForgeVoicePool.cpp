@@ -0,0 +1,298 @@
+// Core/ForgeVoicePool.cpp
+#include "ForgeVoicePool.h"
+#include <cstring>
+#include <limits>
+
+ForgeVoicePool::ForgeVoicePool()
+{
+    for (int i = 0; i < maxVoices; ++i)
+        info[(size_t)i].nextFree = i + 1 < maxVoices ? i + 1 : none;
+
+    noteTable.fill(none);
+}
+
+void ForgeVoicePool::prepare(double sampleRate, int blockSize)
+{
+    killAll();
+
+    for (auto& v : voices)
+        v.prepare(sampleRate, blockSize);
+
+    const int fadeLength = juce::jmax(1, juce::roundToInt(sampleRate * stealFadeSeconds));
+    stealTail.setSize(2, fadeLength);
+    stealScratch.setSize(2, fadeLength);
+    stealTail.clear();
+    stealTailRead = stealTailEnd = 0;
+}
+
+//==============================================================================
+void ForgeVoicePool::handleMidiMessage(const juce::MidiMessage& message,
+                                       const std::array<ForgeVoice, numSlots>& slots)
+{
+    if (message.isNoteOn())
+        noteOn(message.getChannel(), message.getNoteNumber(), message.getFloatVelocity(), slots);
+    else if (message.isNoteOff())
+        noteOff(message.getChannel(), message.getNoteNumber());
+    else if (message.isAllNotesOff())
+        allNotesOff();
+    else if (message.isAllSoundOff())
+        killAll();
+}
+
+void ForgeVoicePool::noteOn(int channel, int note, float velocity,
+                            const std::array<ForgeVoice, numSlots>& slots)
+{
+    if (!juce::isPositiveAndBelow(channel - 1, numChannels) || !juce::isPositiveAndBelow(note, numNotes))
+        return;
+
+    const int slot = getSlotForChannel(channel);
+    if (!slots[(size_t)slot].hasSample())
+        return;
+
+    // Retriggering a held note lets the old voice ring out
+    const int key = keyFor(channel, note);
+    if (noteTable[(size_t)key] != none)
+        releaseKey(noteTable[(size_t)key]);
+
+    const int index = allocateVoice();
+    auto& n = info[(size_t)index];
+    n.slot = slot;
+    n.key = key;
+    n.pitchRatio = std::pow(2.0f, (float)(note - rootNote) / 12.0f);
+    n.gain = velocity;
+    noteTable[(size_t)key] = index;
+
+    voices[(size_t)index].startNote(slots[(size_t)slot], n.pitchRatio, n.gain);
+}
+
+void ForgeVoicePool::noteOff(int channel, int note)
+{
+    if (!juce::isPositiveAndBelow(channel - 1, numChannels) || !juce::isPositiveAndBelow(note, numNotes))
+        return;
+
+    const int index = noteTable[(size_t)keyFor(channel, note)];
+    if (index != none)
+        releaseKey(index);
+}
+
+void ForgeVoicePool::allNotesOff()
+{
+    for (int i = oldest; i != none; i = info[(size_t)i].newer)
+        releaseKey(i);
+}
+
+void ForgeVoicePool::killAll()
+{
+    while (oldest != none)
+        freeVoice(oldest);
+
+    stealTailRead = stealTailEnd = 0;
+}
+
+void ForgeVoicePool::killSlot(int slotIndex)
+{
+    for (int i = oldest; i != none;)
+    {
+        const int next = info[(size_t)i].newer;
+        if (info[(size_t)i].slot == slotIndex)
+            freeVoice(i);
+        i = next;
+    }
+}
+
+//==============================================================================
+void ForgeVoicePool::render(const std::array<ForgeVoice, numSlots>& slots, juce::AudioBuffer<float>& output,
+                            int startSample, int numSamples, ForgeLaneRenderer* lanes, bool forceLanes)
+{
+    mixStealTail(output, startSample, numSamples);
+
+    if (numActive == 0 || numSamples <= 0)
+        return;
+
+    int batchSize = 0;
+    const auto flushBatch = [&]
+    {
+        // A single voice is cheaper on its own
+        if (batchSize > 1 || (forceLanes && batchSize == 1))
+            lanes->process(batch.data(), batchSize, output, startSample, numSamples);
+        else if (batchSize == 1)
+            batch[0]->process(output, startSample, numSamples);
+
+        batchSize = 0;
+    };
+
+    for (int i = oldest; i != none; i = info[(size_t)i].newer)
+    {
+        const auto& n = info[(size_t)i];
+        auto& voice = voices[(size_t)i];
+        voice.followSlot(slots[(size_t)n.slot], n.pitchRatio, n.gain);
+
+        if (lanes != nullptr && (forceLanes || ForgeLaneRenderer::isLaneExact(voice)))
+        {
+            batch[(size_t)batchSize++] = &voice;
+            if (batchSize == ForgeLaneRenderer::numLanes)
+                flushBatch();
+        }
+        else
+        {
+            voice.process(output, startSample, numSamples);
+        }
+    }
+
+    flushBatch();
+
+    // Voices that finished their release go back on the free list
+    for (int i = oldest; i != none;)
+    {
+        const int next = info[(size_t)i].newer;
+        if (!voices[(size_t)i].isActive())
+            freeVoice(i);
+        i = next;
+    }
+}
+
+void ForgeVoicePool::takeSlotLevels(std::array<float, numSlots>& levels, std::array<int, numSlots>& notesPerSlot)
+{
+    for (int i = oldest; i != none; i = info[(size_t)i].newer)
+    {
+        const auto slot = (size_t)info[(size_t)i].slot;
+        levels[slot] = juce::jmax(levels[slot], voices[(size_t)i].takePeakLevel());
+        ++notesPerSlot[slot];
+    }
+}
+
+//==============================================================================
+int ForgeVoicePool::allocateVoice()
+{
+    int index = firstFree;
+
+    if (index != none)
+    {
+        firstFree = info[(size_t)index].nextFree;
+    }
+    else
+    {
+        index = chooseVictim();
+        fadeOutVoice(index);
+        freeVoice(index);
+        firstFree = info[(size_t)index].nextFree;
+    }
+
+    // Newest end of the age list
+    auto& n = info[(size_t)index];
+    n.older = newest;
+    n.newer = none;
+    n.nextFree = none;
+
+    if (newest != none)
+        info[(size_t)newest].newer = index;
+    else
+        oldest = index;
+
+    newest = index;
+    ++numActive;
+    return index;
+}
+
+int ForgeVoicePool::chooseVictim() const
+{
+    if (stealMode == StealMode::Oldest)
+        return oldest;
+
+    // Quietest: released voices are on their way out, so they go first
+    int victim = oldest;
+    float quietest = std::numeric_limits<float>::max();
+
+    for (int i = oldest; i != none; i = info[(size_t)i].newer)
+    {
+        const auto& voice = voices[(size_t)i];
+        const float level = voice.isReleasing() ? voice.getCurrentGain() * 0.5f : voice.getCurrentGain();
+
+        if (level < quietest)
+        {
+            quietest = level;
+            victim = i;
+        }
+    }
+
+    return victim;
+}
+
+void ForgeVoicePool::freeVoice(int index)
+{
+    releaseKey(index);
+    voices[(size_t)index].killNote();
+
+    auto& n = info[(size_t)index];
+    n.slot = none;
+
+    if (n.older != none)
+        info[(size_t)n.older].newer = n.newer;
+    else
+        oldest = n.newer;
+
+    if (n.newer != none)
+        info[(size_t)n.newer].older = n.older;
+    else
+        newest = n.older;
+
+    n.older = n.newer = none;
+    n.nextFree = firstFree;
+    firstFree = index;
+    --numActive;
+}
+
+void ForgeVoicePool::fadeOutVoice(int index)
+{
+    const int fadeLength = stealTail.getNumSamples();
+    if (fadeLength == 0)
+        return;
+
+    // Whatever is left of an earlier steal moves to the front and plays under this one
+    const int pending = stealTailEnd - stealTailRead;
+    for (int ch = 0; ch < stealTail.getNumChannels(); ++ch)
+    {
+        auto* tail = stealTail.getWritePointer(ch);
+        if (pending > 0 && stealTailRead > 0)
+            std::memmove(tail, tail + stealTailRead, sizeof(float) * (size_t)pending);
+        juce::FloatVectorOperations::clear(tail + pending, fadeLength - pending);
+    }
+
+    stealTailRead = 0;
+    stealTailEnd = fadeLength;
+
+    // The victim carries on for one fade, ramped to silence
+    stealScratch.clear();
+    voices[(size_t)index].process(stealScratch, 0, fadeLength);
+
+    for (int ch = 0; ch < stealTail.getNumChannels(); ++ch)
+    {
+        stealScratch.applyGainRamp(ch, 0, fadeLength, 1.0f, 0.0f);
+        stealTail.addFrom(ch, 0, stealScratch, ch, 0, fadeLength);
+    }
+}
+
+void ForgeVoicePool::mixStealTail(juce::AudioBuffer<float>& output, int startSample, int numSamples)
+{
+    const int num = juce::jmin(numSamples, stealTailEnd - stealTailRead);
+    if (num <= 0)
+        return;
+
+    for (int ch = 0; ch < juce::jmin(output.getNumChannels(), stealTail.getNumChannels()); ++ch)
+        output.addFrom(ch, startSample, stealTail, ch, stealTailRead, num);
+
+    stealTailRead += num;
+}
+
+void ForgeVoicePool::releaseKey(int index)
+{
+    auto& n = info[(size_t)index];
+    if (n.key == none)
+        return;
+
+    if (noteTable[(size_t)n.key] == index)
+        noteTable[(size_t)n.key] = none;
+
+    n.key = none;
+    voices[(size_t)index].releaseNote();
+}
@@ -0,0 +1,99 @@
+// Core/ForgeVoicePool.h
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include "ForgeVoice.h"
+#include "ForgeLaneRenderer.h"
+
+//==============================================================================
+// Preallocated polyphonic voices for playing the Forge slots from MIDI.
+// MIDI channel n plays slot (n - 1) % 8 chromatically, note 60 at the slot's
+// own pitch. Every voice borrows its slot's sample and follows the slot's
+// settings, so a note sounds like the slot played at a different pitch.
+//
+// Free voices sit on a free list and sounding voices on an age-ordered list,
+// with a [channel][note] table for note-offs, so note handling never scans
+// the pool. The only scan is choosing the quietest voice to steal. A stolen
+// voice's next few milliseconds are rendered, faded out and played on from a
+// tail buffer, so stealing never clicks.
+class ForgeVoicePool
+{
+public:
+    static constexpr int maxVoices = 64;
+    static constexpr int numSlots = 8;
+    static constexpr int rootNote = 60;
+    static constexpr double stealFadeSeconds = 0.003;
+
+    enum class StealMode { Oldest = 0, Quietest };
+
+    ForgeVoicePool();
+
+    void prepare(double sampleRate, int blockSize);
+
+    // MIDI
+    void handleMidiMessage(const juce::MidiMessage& message, const std::array<ForgeVoice, numSlots>& slots);
+    void noteOn(int channel, int note, float velocity, const std::array<ForgeVoice, numSlots>& slots);
+    void noteOff(int channel, int note);
+    void allNotesOff();
+    void killAll();
+    void killSlot(int slotIndex);   // the slot's sample is about to change
+
+    // Renders every sounding voice into output. Batches of clean voices go
+    // through lanes when a renderer is given; forceLanes sends every batch.
+    void render(const std::array<ForgeVoice, numSlots>& slots, juce::AudioBuffer<float>& output,
+                int startSample, int numSamples, ForgeLaneRenderer* lanes, bool forceLanes);
+
+    void setStealMode(StealMode mode) { stealMode = mode; }
+    StealMode getStealMode() const { return stealMode; }
+    int getNumActiveVoices() const { return numActive; }
+
+    // Adds each sounding voice's peak since the last call to its slot's level and counts it
+    void takeSlotLevels(std::array<float, numSlots>& levels, std::array<int, numSlots>& notesPerSlot);
+
+    static int getSlotForChannel(int channel) { return (channel - 1) % numSlots; }
+
+private:
+    static constexpr int numChannels = 16;
+    static constexpr int numNotes = 128;
+    static constexpr int none = -1;
+
+    struct NoteInfo
+    {
+        int slot = none;
+        int key = none;        // index into noteTable, none once released
+        float pitchRatio = 1.0f;
+        float gain = 1.0f;
+        int older = none;      // age list neighbours
+        int newer = none;
+        int nextFree = none;
+    };
+
+    int allocateVoice();
+    int chooseVictim() const;
+    void freeVoice(int index);
+    void releaseKey(int index);
+    void fadeOutVoice(int index);
+    void mixStealTail(juce::AudioBuffer<float>& output, int startSample, int numSamples);
+
+    static int keyFor(int channel, int note) { return (channel - 1) * numNotes + note; }
+
+    std::array<ForgeVoice, maxVoices> voices;
+    std::array<NoteInfo, maxVoices> info;
+    std::array<int, numChannels * numNotes> noteTable;   // sounding voice for each channel/note
+
+    int firstFree = 0;
+    int oldest = none;
+    int newest = none;
+    int numActive = 0;
+    StealMode stealMode = StealMode::Oldest;
+
+    std::array<ForgeVoice*, ForgeLaneRenderer::numLanes> batch{};
+
+    // Stolen voices' faded-out endings, played from stealTailRead up to stealTailEnd
+    juce::AudioBuffer<float> stealTail, stealScratch;
+    int stealTailRead = 0;
+    int stealTailEnd = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ForgeVoicePool)
+};
@@ -0,0 +1,98 @@
+#include "ForgeVoice.h"
+#include <JuceHeader.h>
+#include <cmath>
+
+/**
+ * Behaviour tests for ForgeVoice's drive/crush stage.
+ * Clean voices bypass the oversampler; turning drive or crush on or off
+ * crossfades between the two paths, so crossing the clean threshold must
+ * not click.
+ */
+class ForgeVoiceTest
+{
+public:
+    static bool runBasicTests()
+    {
+        DBG("=== ForgeVoice Behaviour Tests ===");
+
+        // Test 1: Drive moving across the clean threshold, block after block
+        if (!testCleanTransitions([](ForgeVoice& v, bool on) { v.setDrive(on ? 1.05f : 1.0f); }, "drive"))
+            return false;
+
+        // Test 2: The same for crush
+        if (!testCleanTransitions([](ForgeVoice& v, bool on) { v.setCrush(on ? 15.9f : 16.0f); }, "crush"))
+            return false;
+
+        DBG("=== All ForgeVoice tests passed! ===");
+        return true;
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 256;
+    static constexpr int numBlocks = 200;
+    static constexpr int toggleEvery = 5;        // blocks between crossings, long enough for each fade to finish
+    static constexpr float frequency = 100.0f;   // 480 samples a cycle, so the loop point is seamless
+    static constexpr float amplitude = 0.5f;
+
+    // Largest step between neighbouring samples of the sine itself, at the voice's default level,
+    // with room for the oversampler's phase shift while the paths overlap
+    static float maxSmoothStep()
+    {
+        return 3.0f * 0.7f * amplitude * juce::MathConstants<float>::twoPi * frequency / (float)sampleRate;
+    }
+
+    template <typename Toggle>
+    static bool testCleanTransitions(Toggle&& toggle, const char* what)
+    {
+        DBG("Testing " << what << " crossing the clean threshold...");
+
+        juce::AudioBuffer<float> sample(2, (int)sampleRate);
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < sample.getNumSamples(); ++i)
+                sample.setSample(ch, i, amplitude * std::sin(juce::MathConstants<float>::twoPi * frequency * (float)i / (float)sampleRate));
+
+        ForgeVoice voice;
+        voice.prepare(sampleRate, blockSize);
+        voice.setSample(std::move(sample));
+        voice.start();
+
+        juce::AudioBuffer<float> output(2, blockSize);
+        float previous = 0.0f;
+        const float limit = maxSmoothStep();
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            if (block % toggleEvery == 0)
+                toggle(voice, (block / toggleEvery) % 2 == 1);
+
+            output.clear();
+            voice.process(output, 0, blockSize);
+
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const float s = output.getSample(0, i);
+                if (block > 0 || i > 0)
+                {
+                    const float step = std::abs(s - previous);
+                    if (step > limit)
+                    {
+                        DBG("FAIL: Step of " << step << " at block " << block << ", sample " << i
+                            << " while switching " << what << " (limit " << limit << ")");
+                        return false;
+                    }
+                }
+                previous = s;
+            }
+        }
+
+        DBG("✓ Clean threshold test for " << what << " passed");
+        return true;
+    }
+};
+
+// Function to run tests (can be called from main application for validation)
+bool testForgeVoice()
+{
+    return ForgeVoiceTest::runBasicTests();
+}
@@ -1,11 +1,11 @@
-/*
-  ==============================================================================
-
-    GrainPool.cpp
-    Created: 31 Jul 2025 2:12:44pm
-    Author:  hooki
-
-  ==============================================================================
-*/
-
-#include "GrainPool.h"
+/*
+  ==============================================================================
+
+    GrainPool.cpp
+    Created: 31 Jul 2025 2:12:44pm
+    Author:  hooki
+
+  ==============================================================================
+*/
+
+#include "GrainPool.h"
@@ -1,11 +1,11 @@
-/*
-  ==============================================================================
-
-    GrainPool.h
-    Created: 31 Jul 2025 2:12:44pm
-    Author:  hooki
-
-  ==============================================================================
-*/
-
-#pragma once
+/*
+  ==============================================================================
+
+    GrainPool.h
+    Created: 31 Jul 2025 2:12:44pm
+    Author:  hooki
+
+  ==============================================================================
+*/
+
+#pragma once
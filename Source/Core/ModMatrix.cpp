@@ -1,11 +1,11 @@
-/*
-  ==============================================================================
-
-    ModMatrix.cpp
-    Created: 31 Jul 2025 2:12:52pm
-    Author:  hooki
-
-  ==============================================================================
-*/
-
-#include "ModMatrix.h"
+/*
+  ==============================================================================
+
+    ModMatrix.cpp
+    Created: 31 Jul 2025 2:12:52pm
+    Author:  hooki
+
+  ==============================================================================
+*/
+
+#include "ModMatrix.h"
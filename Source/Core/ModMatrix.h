@@ -1,11 +1,11 @@
-/*
-  ==============================================================================
-
-    ModMatrix.h
-    Created: 31 Jul 2025 2:12:52pm
-    Author:  hooki
-
-  ==============================================================================
-*/
-
-#pragma once
+/*
+  ==============================================================================
+
+    ModMatrix.h
+    Created: 31 Jul 2025 2:12:52pm
+    Author:  hooki
+
+  ==============================================================================
+*/
+
+#pragma once
@@ -0,0 +1,150 @@
+#pragma once
+#include "Commands.h"
+#include <array>
+#include <atomic>
+
+//==============================================================================
+// Bounded lock-free multi-producer / single-consumer command queue.
+//
+// Each cell carries a sequence number that tells producers and the consumer
+// whose turn it is (Vyukov's bounded queue), so producers only contend on one
+// fetch of the enqueue index and never wait on each other.
+//
+// Producers register once and get an id. Each one may have at most
+// Capacity / MaxProducers commands in flight, so a chatty producer (a file
+// watcher rescanning a folder, say) fills its own share and gets refused
+// while everyone else still gets through.
+template <size_t Capacity = 1024, int MaxProducers = 8>
+class MpscCommandQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    static constexpr int invalidProducer = -1;
+    static constexpr int quotaPerProducer = (int)(Capacity / (size_t)MaxProducers);
+
+    MpscCommandQueue()
+    {
+        for (size_t i = 0; i < Capacity; ++i)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+
+        for (auto& p : producers)
+        {
+            p.inFlight.store(0, std::memory_order_relaxed);
+            p.rejected.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Any thread; returns invalidProducer once MaxProducers have registered
+    int registerProducer() noexcept
+    {
+        const int id = numProducers.fetch_add(1, std::memory_order_relaxed);
+        if (id < MaxProducers)
+            return id;
+
+        numProducers.store(MaxProducers, std::memory_order_relaxed);
+        return invalidProducer;
+    }
+
+    //==============================================================================
+    // Producers
+
+    // False when this producer is over its share or the queue is full
+    bool push(int producerId, const Command& c) noexcept
+    {
+        jassert(juce::isPositiveAndBelow(producerId, MaxProducers));
+        auto& producer = producers[(size_t)producerId];
+
+        if (producer.inFlight.fetch_add(1, std::memory_order_relaxed) >= quotaPerProducer)
+        {
+            producer.inFlight.fetch_sub(1, std::memory_order_relaxed);
+            producer.rejected.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+
+        for (;;)
+        {
+            cell = &cells[pos & mask];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = (std::ptrdiff_t)seq - (std::ptrdiff_t)pos;
+
+            if (diff == 0)
+            {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                // Full; only reachable when quotas add up to more than Capacity
+                producer.inFlight.fetch_sub(1, std::memory_order_relaxed);
+                producer.rejected.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            else
+            {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->command = c;
+        cell->producer = producerId;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    //==============================================================================
+    // Consumer
+
+    bool pop(Command& out) noexcept
+    {
+        Cell& cell = cells[dequeuePos & mask];
+        if (cell.sequence.load(std::memory_order_acquire) != dequeuePos + 1)
+            return false; // empty, or the next producer hasn't finished writing
+
+        out = cell.command;
+        producers[(size_t)cell.producer].inFlight.fetch_sub(1, std::memory_order_relaxed);
+        cell.sequence.store(dequeuePos + Capacity, std::memory_order_release);
+        ++dequeuePos;
+        return true;
+    }
+
+    // Pops up to maxToPop commands into dest, returns how many
+    size_t popInto(Command* dest, size_t maxToPop) noexcept
+    {
+        size_t n = 0;
+        while (n < maxToPop && pop(dest[n]))
+            ++n;
+        return n;
+    }
+
+    size_t getRejectedCount(int producerId) const noexcept
+    {
+        return producers[(size_t)producerId].rejected.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr size_t mask = Capacity - 1;
+
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        int                 producer = 0;
+        Command             command;
+    };
+
+    struct alignas(64) Producer
+    {
+        std::atomic<int>    inFlight;
+        std::atomic<size_t> rejected;
+    };
+
+    std::array<Cell, Capacity> cells;
+    std::array<Producer, (size_t)MaxProducers> producers;
+    std::atomic<int> numProducers{ 0 };
+
+    alignas(64) std::atomic<size_t> enqueuePos{ 0 };
+    alignas(64) size_t dequeuePos = 0;   // consumer only
+};
@@ -130,6 +130,23 @@ void PaintEngine::processBlock(juce::AudioBuffer<float>& buffer)
     }
 }
 
+bool PaintEngine::isIdle() const
+{
+    if (!isActive.load())
+        return true;
+    
+    if (currentStroke != nullptr || activeOscillators.load() > 0)
+        return false;
+    
+    for (const auto& [key, region] : canvasRegions)
+    {
+        if (region != nullptr && !region->isEmpty())
+            return false;
+    }
+    
+    return true;
+}
+
 void PaintEngine::releaseResources()
 {
     const juce::ScopedLock lock(oscillatorLock);
@@ -181,6 +198,25 @@ void PaintEngine::updateStroke(Point position, float pressure)
     updateCanvasOscillators();
 }
 
+void PaintEngine::updateStroke(const Point* positions, const float* pressures, int numPoints)
+{
+    if (numPoints <= 0)
+        return;
+    
+    int first = 0;
+    if (currentStroke == nullptr)
+    {
+        beginStroke(positions[0], pressures[0]);
+        first = 1;
+    }
+    
+    for (int i = first; i < numPoints; ++i)
+        currentStroke->addPoint(StrokePoint(positions[i], pressures[i], juce::Colours::white));
+    
+    // A whole segment costs one oscillator update instead of one per point
+    updateCanvasOscillators();
+}
+
 void PaintEngine::endStroke()
 {
     if (currentStroke == nullptr)
@@ -472,7 +508,7 @@ PaintEngine::Stroke::Stroke(juce::uint32 id)
 void PaintEngine::Stroke::addPoint(const StrokePoint& point)
 {
     points.push_back(point);
-    updateBounds();
+    expandBounds(point.position);
 }
 
 void PaintEngine::Stroke::finalize()
@@ -513,6 +549,21 @@ void PaintEngine::Stroke::updateBounds()
     bounds = juce::Rectangle<float>(minX, minY, maxX - minX, maxY - minY);
 }
 
+void PaintEngine::Stroke::expandBounds(Point position)
+{
+    if (points.size() == 1)
+    {
+        bounds = juce::Rectangle<float>(position.x, position.y, 0.0f, 0.0f);
+        return;
+    }
+    
+    // Rectangle::getUnion() ignores zero-sized rectangles, so widen by hand
+    bounds = juce::Rectangle<float>::leftTopRightBottom(std::min(bounds.getX(), position.x),
+                                                        std::min(bounds.getY(), position.y),
+                                                        std::max(bounds.getRight(), position.x),
+                                                        std::max(bounds.getBottom(), position.y));
+}
+
 bool PaintEngine::Stroke::hasActiveOscillators() const
 {
     // TODO: Implement proper oscillator tracking
@@ -87,6 +87,7 @@ public:
     // Stroke interaction API
     void beginStroke(Point position, float pressure = 1.0f, juce::Colour color = juce::Colours::white);
     void updateStroke(Point position, float pressure = 1.0f);
+    void updateStroke(const Point* positions, const float* pressures, int numPoints);   // one canvas update for the lot
     void endStroke();
     
     // Canvas control
@@ -98,6 +99,7 @@ public:
     // Audio parameters
     void setActive(bool shouldBeActive) { isActive.store(shouldBeActive); }
     bool getActive() const { return isActive.load(); }
+    bool isIdle() const;    // nothing painted, no stroke in progress and no oscillator sounding
     void setMasterGain(float gain);
     void setFrequencyRange(float minHz, float maxHz);
     void setUsePanning(bool shouldUsePanning) { usePanning.store(shouldUsePanning); }
@@ -171,6 +173,7 @@ private:
         // Cached bounds for optimization
         juce::Rectangle<float> bounds;
         void updateBounds();
+        void expandBounds(Point position);
         
         bool hasActiveOscillators() const;
         
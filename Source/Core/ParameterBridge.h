@@ -1,31 +1,85 @@
-// Core/ParameterBridge.h
-#pragma once
-#include <JuceHeader.h>
-#include <atomic>
-
-class ParameterBridge
-{
-public:
-    struct SlotParameters
-    {
-        std::atomic<float> pitch{0.0f};
-        std::atomic<float> speed{1.0f};
-        std::atomic<float> volume{0.7f};
-        std::atomic<float> drive{1.0f};
-        std::atomic<float> crush{16.0f};
-        std::atomic<bool> syncEnabled{false};
-        std::atomic<bool> isPlaying{false};
-        std::atomic<float> playProgress{0.0f};
-    };
-
-    ParameterBridge() = default;
-    
-    SlotParameters& getSlotParams(int slot) 
-    { 
-        jassert(slot >= 0 && slot < 8);
-        return slotParams[slot]; 
-    }
-
-private:
-    std::array<SlotParameters, 8> slotParams;
-};
\ No newline at end of file
+// Core/ParameterBridge.h
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+//==============================================================================
+// Audio -> GUI telemetry. The audio thread fills in a Snapshot once per block
+// and publishes it. The GUI always reads a complete snapshot, never one that is
+// half written, and neither side locks or waits.
+//
+// Triple buffered: the writer owns one copy, the reader owns another and the
+// third is handed between them with a single atomic exchange. A fresh flag
+// rides in the exchanged index so the reader only swaps when something new
+// was published. Unread snapshots are simply overwritten.
+class ParameterBridge
+{
+public:
+    static constexpr int numSlots = 8;
+
+    struct SlotTelemetry
+    {
+        float progress = 0.0f;      // playhead, 0-1 through the sample
+        float level = 0.0f;         // peak output of the slot and its notes this block
+        int   activeNotes = 0;      // MIDI voices playing the slot
+        bool  isPlaying = false;
+        bool  hasSample = false;
+        int   sampleMemoryKB = 0;   // the slot's sample as stored
+        int   memorySavedKB = 0;    // against holding it as float32
+    };
+
+    static constexpr int maxEngines = 4;
+
+    struct EngineTelemetry
+    {
+        float cpuLoad = 0.0f;       // this engine's share of the block time
+        bool  asleep = true;        // skipped while idle and silent
+    };
+
+    struct Snapshot
+    {
+        std::array<SlotTelemetry, numSlots> slots{};
+        std::array<EngineTelemetry, maxEngines> engines{};   // by engine graph node
+        std::array<float, 2> outputLevel{};   // block peak, left / right
+        int   activePartials = 0;             // sounding paint oscillators
+        float cpuLoad = 0.0f;                 // processBlock time / block duration
+        juce::uint32 blockCount = 0;          // increments with every publish
+    };
+
+    ParameterBridge() = default;
+
+    //==============================================================================
+    // Audio thread: fill in the snapshot returned by beginWrite(), then publish()
+
+    Snapshot& beginWrite() noexcept { return buffers[(size_t)writeIndex]; }
+
+    void publish() noexcept
+    {
+        buffers[(size_t)writeIndex].blockCount = ++blockCount;
+        writeIndex = shared.exchange(writeIndex | freshFlag, std::memory_order_acq_rel) & indexMask;
+    }
+
+    //==============================================================================
+    // GUI thread: the newest published snapshot, valid until the next read()
+
+    const Snapshot& read() noexcept
+    {
+        if ((shared.load(std::memory_order_relaxed) & freshFlag) != 0)
+            readIndex = shared.exchange(readIndex, std::memory_order_acq_rel) & indexMask;
+
+        return buffers[(size_t)readIndex];
+    }
+
+private:
+    static constexpr int indexMask = 3;
+    static constexpr int freshFlag = 4;
+
+    std::array<Snapshot, 3> buffers{};
+    alignas(64) std::atomic<int> shared{ 1 };   // the copy in between, plus freshFlag
+    alignas(64) int writeIndex = 0;             // audio thread only
+    juce::uint32 blockCount = 0;
+    alignas(64) int readIndex = 2;              // GUI thread only
+
+    JUCE_DECLARE_NON_COPYABLE(ParameterBridge)
+};
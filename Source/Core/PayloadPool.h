@@ -0,0 +1,93 @@
+// Core/PayloadPool.h
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+// Names an entry in a PayloadPool; small enough to ride inside a Command
+struct PayloadHandle
+{
+    juce::uint32 index;
+
+    static constexpr juce::uint32 invalidIndex = 0xffffffffu;
+    bool isValid() const noexcept { return index != invalidIndex; }
+};
+
+//==============================================================================
+// Preallocated side storage for command payloads that don't fit in a Command,
+// such as decoded samples or paths.
+//
+// The message thread acquires an entry, fills it and sends its handle in a
+// command. The audio thread reads or swaps the contents out and retires the
+// handle. Retired entries are reset on the message thread the next time it
+// acquires one, so the audio thread never frees memory.
+template <typename Payload, int Capacity>
+class PayloadPool
+{
+public:
+    PayloadPool()
+    {
+        for (auto& s : states)
+            s.store(Free, std::memory_order_relaxed);
+    }
+
+    // Message thread
+    PayloadHandle acquire()
+    {
+        collectRetired();
+
+        for (int i = 0; i < Capacity; ++i)
+        {
+            if (states[(size_t)i].load(std::memory_order_acquire) == Free)
+            {
+                states[(size_t)i].store(InUse, std::memory_order_relaxed);
+                return { (juce::uint32)i };
+            }
+        }
+
+        return { PayloadHandle::invalidIndex };
+    }
+
+    // Hands back an entry that was acquired but never sent
+    void cancel(PayloadHandle handle)
+    {
+        jassert(juce::isPositiveAndBelow((int)handle.index, Capacity));
+        entries[handle.index] = Payload();
+        states[handle.index].store(Free, std::memory_order_release);
+    }
+
+    void collectRetired()
+    {
+        for (int i = 0; i < Capacity; ++i)
+        {
+            if (states[(size_t)i].load(std::memory_order_acquire) == Retired)
+            {
+                entries[(size_t)i] = Payload();   // frees whatever the audio thread left behind
+                states[(size_t)i].store(Free, std::memory_order_release);
+            }
+        }
+    }
+
+    // Either thread, while it owns the handle
+    Payload& get(PayloadHandle handle) noexcept
+    {
+        jassert(juce::isPositiveAndBelow((int)handle.index, Capacity));
+        return entries[handle.index];
+    }
+
+    // Audio thread
+    void retire(PayloadHandle handle) noexcept
+    {
+        jassert(juce::isPositiveAndBelow((int)handle.index, Capacity));
+        states[handle.index].store(Retired, std::memory_order_release);
+    }
+
+private:
+    enum State : int { Free = 0, InUse, Retired };
+
+    std::array<Payload, Capacity> entries;
+    std::array<std::atomic<int>, Capacity> states;
+
+    JUCE_DECLARE_NON_COPYABLE(PayloadPool)
+};
@@ -1,332 +1,881 @@
-﻿// Source/PluginProcessor.cpp
-#include "PluginProcessor.h"
-#include "GUI/PluginEditor.h"
-
-//==============================================================================
-// Constructor and Destructor
-
-ARTEFACTAudioProcessor::ARTEFACTAudioProcessor()
-    : AudioProcessor(BusesProperties()
-#if ! JucePlugin_IsMidiEffect
-    #if ! JucePlugin_IsSynth
-                     .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
-    #endif
-                     .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
-#endif
-                     ),
-      apvts(*this, nullptr, "Parameters", createParameterLayout())
-{
-    // Register as parameter listener for automatic parameter updates
-    apvts.addParameterListener("masterGain", this);
-    apvts.addParameterListener("paintActive", this);
-    apvts.addParameterListener("processingMode", this);
-}
-
-ARTEFACTAudioProcessor::~ARTEFACTAudioProcessor()
-{
-    apvts.removeParameterListener("masterGain", this);
-    apvts.removeParameterListener("paintActive", this);
-    apvts.removeParameterListener("processingMode", this);
-}
-
-//==============================================================================
-// Audio Processing Lifecycle
-
-void ARTEFACTAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
-{
-    currentSampleRate = sampleRate;
-    
-    // Prepare both processors
-    forgeProcessor.prepareToPlay(sampleRate, samplesPerBlock);
-    paintEngine.prepareToPlay(sampleRate, samplesPerBlock);
-    
-    // Set default active state based on current mode
-    paintEngine.setActive(currentMode == ProcessingMode::Canvas || currentMode == ProcessingMode::Hybrid);
-}
-
-void ARTEFACTAudioProcessor::releaseResources()
-{
-    paintEngine.releaseResources();
-    // Note: ForgeProcessor doesn't have releaseResources() method yet
-}
-
-//==============================================================================
-// Parameter Management
-
-juce::AudioProcessorValueTreeState::ParameterLayout ARTEFACTAudioProcessor::createParameterLayout()
-{
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> parameters;
-    
-    // Master gain parameter
-    parameters.push_back(std::make_unique<juce::AudioParameterFloat>(
-        "masterGain", "Master Gain", 0.0f, 2.0f, 0.7f));
-    
-    // Paint engine active parameter
-    parameters.push_back(std::make_unique<juce::AudioParameterBool>(
-        "paintActive", "Paint Active", false));
-    
-    // Processing mode parameter
-    parameters.push_back(std::make_unique<juce::AudioParameterChoice>(
-        "processingMode", "Processing Mode", 
-        juce::StringArray{"Forge", "Canvas", "Hybrid"}, 0));
-    
-    return { parameters.begin(), parameters.end() };
-}
-
-void ARTEFACTAudioProcessor::parameterChanged(const juce::String& parameterID, float newValue)
-{
-    if (parameterID == "masterGain")
-    {
-        paintEngine.setMasterGain(newValue);
-    }
-    else if (parameterID == "paintActive")
-    {
-        paintEngine.setActive(newValue > 0.5f);
-    }
-    else if (parameterID == "processingMode")
-    {
-        int modeIndex = static_cast<int>(newValue);
-        currentMode = static_cast<ProcessingMode>(modeIndex);
-        
-        // Update paint engine active state based on mode
-        bool shouldBeActive = (currentMode == ProcessingMode::Canvas || 
-                              currentMode == ProcessingMode::Hybrid);
-        paintEngine.setActive(shouldBeActive);
-    }
-}
-
-//==============================================================================
-// Editor Management
-
-juce::AudioProcessorEditor* ARTEFACTAudioProcessor::createEditor()
-{
-    return new PluginEditor(*this);
-}
-
-//==============================================================================
-// Bus Layout Support
-
-bool ARTEFACTAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
-{
-#if JucePlugin_IsMidiEffect
-    juce::ignoreUnused(layouts);
-    return true;
-#else
-    // Only mono/stereo supported
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-        && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
-        return false;
-
-#if ! JucePlugin_IsSynth
-    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
-        return false;
-#endif
-
-    return true;
-#endif
-}
-
-//==============================================================================
-// State Management
-
-void ARTEFACTAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
-{
-    // Save plugin state
-    auto state = apvts.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
-}
-
-void ARTEFACTAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
-{
-    // Restore plugin state
-    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
-    if (xmlState.get() != nullptr)
-    {
-        if (xmlState->hasTagName(apvts.state.getType()))
-        {
-            apvts.replaceState(juce::ValueTree::fromXml(*xmlState));
-        }
-    }
-}
-
-//==============================================================================
-// Command Queue Management
-
-bool ARTEFACTAudioProcessor::pushCommandToQueue(const Command& newCommand)
-{
-    int start, end;
-    abstractFifo.prepareToWrite(1, start, end);
-    if (start != end)
-    {
-        commandFIFO[start] = newCommand;
-        abstractFifo.finishedWrite(1);
-        return true;
-    }
-    return false;
-}
-
-void ARTEFACTAudioProcessor::processNextCommand()
-{
-    if (abstractFifo.getNumReady() == 0)
-        return;
-
-    int start, end;
-    abstractFifo.prepareToRead(1, start, end);
-    if (start != end)
-    {
-        const auto& cmd = commandFIFO[start];
-        
-        // Route command based on type
-        if (cmd.isForgeCommand())
-        {
-            processForgeCommand(cmd);
-        }
-        else if (cmd.isPaintCommand())
-        {
-            processPaintCommand(cmd);
-        }
-        
-        abstractFifo.finishedRead(1);
-    }
-}
-
-void ARTEFACTAudioProcessor::processForgeCommand(const Command& cmd)
-{
-    switch (cmd.getForgeCommandID())
-    {
-    case ForgeCommandID::StartPlayback:
-        forgeProcessor.getVoice(cmd.intParam).start();
-        break;
-    case ForgeCommandID::StopPlayback:
-        forgeProcessor.getVoice(cmd.intParam).stop();
-        break;
-    case ForgeCommandID::LoadSample:
-        forgeProcessor.loadSampleIntoSlot(cmd.intParam, juce::File(cmd.stringParam));
-        break;
-    case ForgeCommandID::SetPitch:
-        forgeProcessor.getVoice(cmd.intParam).setPitch(cmd.floatParam);
-        break;
-    case ForgeCommandID::SetSpeed:
-        forgeProcessor.getVoice(cmd.intParam).setSpeed(cmd.floatParam);
-        break;
-    case ForgeCommandID::SetVolume:
-        forgeProcessor.getVoice(cmd.intParam).setVolume(cmd.floatParam);
-        break;
-    case ForgeCommandID::SetDrive:
-        forgeProcessor.getVoice(cmd.intParam).setDrive(cmd.floatParam);
-        break;
-    case ForgeCommandID::SetCrush:
-        forgeProcessor.getVoice(cmd.intParam).setCrush(cmd.floatParam);
-        break;
-    case ForgeCommandID::SetSyncMode:
-        forgeProcessor.getVoice(cmd.intParam).setSyncMode(cmd.boolParam);
-        break;
-    default:
-        break;
-    }
-}
-
-void ARTEFACTAudioProcessor::processPaintCommand(const Command& cmd)
-{
-    switch (cmd.getPaintCommandID())
-    {
-    case PaintCommandID::BeginStroke:
-        paintEngine.beginStroke(PaintEngine::Point(cmd.x, cmd.y), cmd.pressure, cmd.color);
-        break;
-    case PaintCommandID::UpdateStroke:
-        paintEngine.updateStroke(PaintEngine::Point(cmd.x, cmd.y), cmd.pressure);
-        break;
-    case PaintCommandID::EndStroke:
-        paintEngine.endStroke();
-        break;
-    case PaintCommandID::ClearCanvas:
-        paintEngine.clearCanvas();
-        break;
-    case PaintCommandID::SetPlayheadPosition:
-        paintEngine.setPlayheadPosition(cmd.floatParam);
-        break;
-    case PaintCommandID::SetPaintActive:
-        paintEngine.setActive(cmd.boolParam);
-        break;
-    case PaintCommandID::SetMasterGain:
-        paintEngine.setMasterGain(cmd.floatParam);
-        break;
-    case PaintCommandID::SetFrequencyRange:
-        paintEngine.setFrequencyRange(cmd.floatParam, static_cast<float>(cmd.doubleParam));
-        break;
-    case PaintCommandID::SetCanvasRegion:
-        paintEngine.setCanvasRegion(cmd.x, cmd.y, cmd.floatParam, static_cast<float>(cmd.doubleParam));
-        break;
-    default:
-        break;
-    }
-}
-
-void ARTEFACTAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
-{
-    juce::ScopedNoDenormals noDenormals;
-    
-    // Process all pending commands
-    for (int i = 0; i < fifoSize && abstractFifo.getNumReady() > 0; ++i)
-        processNextCommand();
-
-    // Update BPM if available from host
-    if (auto playHead = getPlayHead())
-    {
-        if (auto positionInfo = playHead->getPosition())
-        {
-            if (positionInfo->getBpm().hasValue())
-            {
-                double hostBPM = *positionInfo->getBpm();
-                if (std::abs(hostBPM - lastKnownBPM) > 0.1)
-                {
-                    lastKnownBPM = hostBPM;
-                    forgeProcessor.setHostBPM(hostBPM);
-                }
-            }
-        }
-    }
-
-    // Process audio based on current mode
-    switch (currentMode)
-    {
-    case ProcessingMode::Canvas:
-        // Canvas mode: Only PaintEngine
-        paintEngine.processBlock(buffer);
-        break;
-        
-    case ProcessingMode::Forge:
-        // Forge mode: Only ForgeProcessor
-        forgeProcessor.processBlock(buffer, midi);
-        break;
-        
-    case ProcessingMode::Hybrid:
-        // Hybrid mode: Mix both processors
-        {
-            juce::AudioBuffer<float> paintBuffer(buffer.getNumChannels(), buffer.getNumSamples());
-            paintBuffer.clear();
-            
-            // Process paint engine into separate buffer
-            paintEngine.processBlock(paintBuffer);
-            
-            // Process forge engine into main buffer
-            forgeProcessor.processBlock(buffer, midi);
-            
-            // Mix the two signals (50/50 for now - could be parameterized)
-            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-            {
-                buffer.addFrom(ch, 0, paintBuffer, ch, 0, buffer.getNumSamples(), 0.5f);
-            }
-        }
-        break;
-    }
-}
-
-//==============================================================================
-// Plugin Factory
-
-juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
-{
-    return new ARTEFACTAudioProcessor();
-}
+﻿// Source/PluginProcessor.cpp
+#include "PluginProcessor.h"
+#include "GUI/PluginEditor.h"
+#include "Core/EngineNodes.h"
+
+//==============================================================================
+// Constructor and Destructor
+
+ARTEFACTAudioProcessor::ARTEFACTAudioProcessor()
+    : AudioProcessor(BusesProperties()
+#if ! JucePlugin_IsMidiEffect
+    #if ! JucePlugin_IsSynth
+                     .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
+    #endif
+                     .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
+#endif
+                     ),
+      apvts(*this, nullptr, "Parameters", createParameterLayout())
+{
+    // Independent sources for now; effects would connect after them
+    forgeNode = engineGraph.addNode(std::make_unique<ForgeNode>(forgeProcessor));
+    paintNode = engineGraph.addNode(std::make_unique<PaintNode>(paintEngine));
+    canvasNode = engineGraph.addNode(std::make_unique<CanvasNode>(canvasProcessor));
+    updateEngineRouting();
+
+    // Register as parameter listener for automatic parameter updates
+    apvts.addParameterListener("masterGain", this);
+    apvts.addParameterListener("paintActive", this);
+    apvts.addParameterListener("processingMode", this);
+    apvts.addParameterListener("hybridBalance", this);
+    apvts.addParameterListener("spectralActive", this);
+    apvts.addParameterListener("spectralShift", this);
+    apvts.addParameterListener("spectralStretch", this);
+
+    pendingCommands.reserve(512);
+    canvasImageProducer = registerCommandProducer();
+    sampleLoaderProducer = registerCommandProducer();
+    sampleEditorProducer = registerCommandProducer();
+
+    // Picks up commands staged while the queue was nearly full
+    startTimerHz(30);
+}
+
+ARTEFACTAudioProcessor::~ARTEFACTAudioProcessor()
+{
+    stopTimer();
+    cancelPendingUpdate();
+    apvts.removeParameterListener("masterGain", this);
+    apvts.removeParameterListener("paintActive", this);
+    apvts.removeParameterListener("processingMode", this);
+    apvts.removeParameterListener("hybridBalance", this);
+    apvts.removeParameterListener("spectralActive", this);
+    apvts.removeParameterListener("spectralShift", this);
+    apvts.removeParameterListener("spectralStretch", this);
+    canvasImageLoader.removeAllJobs(true, 2000);
+    sampleLoader.removeAllJobs(true, 2000);
+    sampleEditor.removeAllJobs(true, 2000);
+}
+
+//==============================================================================
+// Audio Processing Lifecycle
+
+void ARTEFACTAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
+{
+    currentSampleRate = sampleRate;
+    previousBlockTicks = 0;
+    
+    // Prepares every engine
+    engineGraph.prepare(sampleRate, getTotalNumOutputChannels(), samplesPerBlock);
+    spectralProcessor.prepare(sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+    spectralWet.setSize(getTotalNumOutputChannels(), juce::jmax(1, samplesPerBlock));
+    spectralMix.reset(sampleRate, spectralFadeSeconds);
+    spectralMix.setCurrentAndTargetValue(0.0f);
+    spectralRunning = false;
+    setLatencySamples(spectralActive.load() ? spectralProcessor.getLatencySamples() : 0);
+    
+    // Set default active state based on current mode
+    paintEngine.setActive(currentMode == ProcessingMode::Canvas || currentMode == ProcessingMode::Hybrid);
+}
+
+void ARTEFACTAudioProcessor::releaseResources()
+{
+    paintEngine.releaseResources();
+    // Note: ForgeProcessor doesn't have releaseResources() method yet
+}
+
+//==============================================================================
+// Parameter Management
+
+juce::AudioProcessorValueTreeState::ParameterLayout ARTEFACTAudioProcessor::createParameterLayout()
+{
+    std::vector<std::unique_ptr<juce::RangedAudioParameter>> parameters;
+    
+    // Master gain parameter
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "masterGain", "Master Gain", 0.0f, 2.0f, 0.7f));
+    
+    // Paint engine active parameter
+    parameters.push_back(std::make_unique<juce::AudioParameterBool>(
+        "paintActive", "Paint Active", false));
+    
+    // Processing mode parameter
+    parameters.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "processingMode", "Processing Mode", 
+        juce::StringArray{"Forge", "Canvas", "Hybrid"}, 0));
+    
+    // Hybrid mix: 0 = Forge only, 0.5 = both at unity, 1 = Paint only.
+    // The default keeps the old fixed mix, Forge at unity and Paint at half.
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "hybridBalance", "Hybrid Balance", 0.0f, 1.0f, 0.25f));
+    
+    // Spectral stage on the master output. Adds an FFT frame of latency while on.
+    parameters.push_back(std::make_unique<juce::AudioParameterBool>(
+        "spectralActive", "Spectral Active", false));
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "spectralShift", "Spectral Shift", -24.0f, 24.0f, 0.0f));
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "spectralStretch", "Spectral Stretch", 0.5f, 2.0f, 1.0f));
+    
+    return { parameters.begin(), parameters.end() };
+}
+
+void ARTEFACTAudioProcessor::parameterChanged(const juce::String& parameterID, float newValue)
+{
+    if (parameterID == "masterGain")
+    {
+        paintEngine.setMasterGain(newValue);
+    }
+    else if (parameterID == "paintActive")
+    {
+        paintEngine.setActive(newValue > 0.5f);
+    }
+    else if (parameterID == "processingMode")
+    {
+        int modeIndex = static_cast<int>(newValue);
+        currentMode = static_cast<ProcessingMode>(modeIndex);
+        
+        // Update paint engine active state based on mode
+        bool shouldBeActive = (currentMode == ProcessingMode::Canvas || 
+                              currentMode == ProcessingMode::Hybrid);
+        paintEngine.setActive(shouldBeActive);
+        updateEngineRouting();
+    }
+    else if (parameterID == "hybridBalance")
+    {
+        hybridBalance.store(newValue);
+        updateEngineRouting();
+    }
+    else if (parameterID == "spectralActive")
+    {
+        // Hosts may call this from the audio thread, where setLatencySamples mustn't run
+        spectralActive.store(newValue > 0.5f);
+        triggerAsyncUpdate();
+    }
+    else if (parameterID == "spectralShift")
+    {
+        spectralShift.store(newValue);
+    }
+    else if (parameterID == "spectralStretch")
+    {
+        spectralStretch.store(newValue);
+    }
+}
+
+void ARTEFACTAudioProcessor::updateEngineRouting()
+{
+    float forgeGain = 1.0f, paintGain = 1.0f;
+
+    // Hybrid balance: one side stays at unity while the other fades out
+    if (currentMode == ProcessingMode::Hybrid)
+    {
+        const float balance = hybridBalance.load();
+        forgeGain = juce::jmin(1.0f, 2.0f * (1.0f - balance));
+        paintGain = juce::jmin(1.0f, 2.0f * balance);
+    }
+
+    const bool forgeOn = currentMode != ProcessingMode::Canvas;
+    const bool paintOn = currentMode != ProcessingMode::Forge;
+
+    engineGraph.setNodeEnabled(forgeNode, forgeOn);
+    engineGraph.setOutputGain(forgeNode, forgeGain);
+
+    for (const int node : { paintNode, canvasNode })
+    {
+        engineGraph.setNodeEnabled(node, paintOn);
+        engineGraph.setOutputGain(node, paintGain);
+    }
+}
+
+//==============================================================================
+// Editor Management
+
+juce::AudioProcessorEditor* ARTEFACTAudioProcessor::createEditor()
+{
+    return new ARTEFACTAudioProcessorEditor(*this);
+}
+
+//==============================================================================
+// Bus Layout Support
+
+bool ARTEFACTAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
+{
+#if JucePlugin_IsMidiEffect
+    juce::ignoreUnused(layouts);
+    return true;
+#else
+    // Only mono/stereo supported
+    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
+        && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+        return false;
+
+#if ! JucePlugin_IsSynth
+    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
+        return false;
+#endif
+
+    return true;
+#endif
+}
+
+//==============================================================================
+// State Management
+
+void ARTEFACTAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
+{
+    // Save plugin state
+    auto state = apvts.copyState();
+    std::unique_ptr<juce::XmlElement> xml(state.createXml());
+    copyXmlToBinary(*xml, destData);
+}
+
+void ARTEFACTAudioProcessor::setStateInformation(const void* data, int sizeInBytes)
+{
+    // Restore plugin state
+    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
+    if (xmlState.get() != nullptr)
+    {
+        if (xmlState->hasTagName(apvts.state.getType()))
+        {
+            apvts.replaceState(juce::ValueTree::fromXml(*xmlState));
+        }
+    }
+}
+
+//==============================================================================
+// Command Queue Management
+
+bool ARTEFACTAudioProcessor::pushCommandToQueue(const Command& newCommand)
+{
+    Command stamped = newCommand;
+    if (stamped.timestamp == 0)
+        stamped.timestamp = juce::Time::getHighResolutionTicks();
+
+    return commandQueue.push(stamped);
+}
+
+int ARTEFACTAudioProcessor::registerCommandProducer()
+{
+    return sharedCommandQueue.registerProducer();
+}
+
+bool ARTEFACTAudioProcessor::pushCommandFrom(int producerId, const Command& newCommand)
+{
+    if (producerId == decltype(sharedCommandQueue)::invalidProducer)
+        return false;
+
+    Command stamped = newCommand;
+    if (stamped.timestamp == 0)
+        stamped.timestamp = juce::Time::getHighResolutionTicks();
+
+    return sharedCommandQueue.push(producerId, stamped);
+}
+
+// Collects everything due by blockTicks from both queues into pendingCommands,
+// ordered by timestamp. Returns how many of them are due; later ones stay
+// pending for the next block.
+int ARTEFACTAudioProcessor::gatherDueCommands(juce::int64 blockTicks)
+{
+    const auto room = [this] { return pendingCommands.size() < pendingCommands.capacity(); };
+
+    const auto batch = commandQueue.beginRead();
+    size_t consumed = 0;
+    for (; consumed < batch.size() && room(); ++consumed)
+    {
+        if (batch[consumed].timestamp > blockTicks)
+            break;
+        pendingCommands.push_back(batch[consumed]);
+    }
+    commandQueue.endRead(consumed);
+
+    Command cmd;
+    while (room() && sharedCommandQueue.pop(cmd))
+        pendingCommands.push_back(cmd);
+
+    // Insertion sort: each queue is already close to time order, and unlike
+    // std::stable_sort this never allocates
+    for (size_t i = 1; i < pendingCommands.size(); ++i)
+    {
+        const Command c = pendingCommands[i];
+        size_t j = i;
+        for (; j > 0 && pendingCommands[j - 1].timestamp > c.timestamp; --j)
+            pendingCommands[j] = pendingCommands[j - 1];
+        pendingCommands[j] = c;
+    }
+
+    int numDue = 0;
+    while (numDue < (int)pendingCommands.size() && pendingCommands[(size_t)numDue].timestamp <= blockTicks)
+        ++numDue;
+
+    return numDue;
+}
+
+void ARTEFACTAudioProcessor::flushPendingCommands()
+{
+    commandQueue.flushStaged();
+}
+
+void ARTEFACTAudioProcessor::timerCallback()
+{
+    flushPendingCommands();
+}
+
+void ARTEFACTAudioProcessor::handleAsyncUpdate()
+{
+    setLatencySamples(spectralActive.load() ? spectralProcessor.getLatencySamples() : 0);
+}
+
+void ARTEFACTAudioProcessor::applyCommand(const Command& cmd)
+{
+    // Route command based on type
+    if (cmd.isForgeCommand())
+    {
+        processForgeCommand(cmd);
+    }
+    else if (cmd.isPaintCommand())
+    {
+        processPaintCommand(cmd);
+    }
+}
+
+bool ARTEFACTAudioProcessor::requestSampleLoad(int slotIndex, const juce::File& file)
+{
+    const auto handle = samplePayloads.acquire();
+    if (!handle.isValid())
+        return false;
+
+    const auto serial = ++nextSampleSerial;
+
+    sampleLoader.addJob([this, slotIndex, file, handle, serial]
+    {
+        auto& prepared = samplePayloads.get(handle);
+        prepared.serial = serial;
+
+        if (!forgeProcessor.prepareSample(file, prepared))
+        {
+            samplePayloads.cancel(handle);
+            return;
+        }
+
+        if (!pushCommandFrom(sampleLoaderProducer, Command(ForgeCommandID::LoadSample, slotIndex, handle)))
+        {
+            samplePayloads.cancel(handle);
+            return;
+        }
+
+        if (juce::isPositiveAndBelow(slotIndex, (int)slotFiles.size()))
+        {
+            const juce::SpinLock::ScopedLockType lock(slotFilesLock);
+            slotFiles[(size_t)slotIndex] = file;
+            slotSerials[(size_t)slotIndex] = serial;
+        }
+    });
+
+    return true;
+}
+
+bool ARTEFACTAudioProcessor::getSlotSource(int slotIndex, juce::File& file, juce::uint32& serial) const
+{
+    if (!juce::isPositiveAndBelow(slotIndex, (int)slotFiles.size()))
+        return false;
+
+    const juce::SpinLock::ScopedLockType lock(slotFilesLock);
+    file = slotFiles[(size_t)slotIndex];
+    serial = slotSerials[(size_t)slotIndex];
+    return file != juce::File();
+}
+
+bool ARTEFACTAudioProcessor::requestCanvasImage(const juce::Image& image)
+{
+    const auto handle = canvasImagePayloads.acquire();
+    if (!handle.isValid())
+        return false;
+
+    // Shared, not copied: callers hand over images they no longer draw into
+    canvasImageLoader.addJob([this, handle, source = image]
+    {
+        if (!CanvasProcessor::prepareImage(source, canvasImagePayloads.get(handle))
+            || !pushCommandFrom(canvasImageProducer, Command(ForgeCommandID::LoadCanvasImage, 0, handle)))
+        {
+            canvasImagePayloads.cancel(handle);
+        }
+    });
+
+    return true;
+}
+
+bool ARTEFACTAudioProcessor::requestTiledCanvas(const juce::File& tileFile)
+{
+    const auto handle = canvasImagePayloads.acquire();
+    if (!handle.isValid())
+        return false;
+
+    if (!CanvasProcessor::prepareTiledImage(tileFile, canvasImagePayloads.get(handle))
+        || !pushCommandToQueue(Command(ForgeCommandID::LoadCanvasImage, 0, handle)))
+    {
+        canvasImagePayloads.cancel(handle);
+        return false;
+    }
+
+    return true;
+}
+
+bool ARTEFACTAudioProcessor::requestSlotAnalysis(int slotIndex)
+{
+    juce::File file;
+    juce::uint32 serial = 0;
+    if (!getSlotSource(slotIndex, file, serial))
+        return false;
+
+    const auto handle = canvasImagePayloads.acquire();
+    if (!handle.isValid())
+        return false;
+
+    canvasImageLoader.addJob([this, handle, file]
+    {
+        const SpectrogramAnalyzer::Settings settings;
+        auto& dest = canvasImagePayloads.get(handle);
+        const auto reader = spectrogramAnalyzer.createReader(file);
+
+        bool ok = reader != nullptr;
+        if (ok)
+        {
+            const auto bytes = (juce::int64)spectrogramAnalyzer.getNumColumns(reader->lengthInSamples, settings)
+                               * settings.numRows * 2 * (juce::int64)sizeof(float);
+
+            if (bytes <= maxInMemoryCanvasBytes)
+            {
+                juce::AudioBuffer<float> audio;
+                ok = spectrogramAnalyzer.loadAudio(*reader, audio)
+                     && spectrogramAnalyzer.analyze(audio, reader->sampleRate, settings, dest);
+            }
+            else
+            {
+                // Too long to hold: decoded a chunk at a time straight into tiles
+                const auto tileFile = juce::File::createTempFile(".actl");
+                ok = spectrogramAnalyzer.analyzeToTiles(*reader, settings, tileFile)
+                     && CanvasProcessor::prepareTiledImage(tileFile, dest, true);
+                if (!ok)
+                    tileFile.deleteFile();
+            }
+        }
+
+        if (!ok || !pushCommandFrom(canvasImageProducer, Command(ForgeCommandID::LoadCanvasImage, 0, handle)))
+        {
+            canvasImagePayloads.cancel(handle);
+            return;
+        }
+
+        // Rows and columns line up with the original's pitch and timing
+        Command range(ForgeCommandID::SetCanvasFreqRange);
+        range.value = { settings.minFreq, settings.maxFreq, false };
+        pushCommandFrom(canvasImageProducer, range);
+        pushCommandFrom(canvasImageProducer, Command(ForgeCommandID::SetCanvasPlayhead, 0.0f));
+        pushCommandFrom(canvasImageProducer,
+                        Command(ForgeCommandID::SetCanvasSweepDuration, (float)(reader->lengthInSamples / reader->sampleRate)));
+    });
+
+    return true;
+}
+
+bool ARTEFACTAudioProcessor::requestSpectralEdit(int slotIndex, const SampleSpectrum::Brush& brush)
+{
+    juce::File file;
+    juce::uint32 serial = 0;
+    if (!getSlotSource(slotIndex, file, serial))
+        return false;
+
+    ++pendingSpectralEdits;
+
+    sampleEditor.addJob([this, slotIndex, brush, file, serial]
+    {
+        auto& spectrum = slotSpectra[(size_t)slotIndex];
+
+        // First dab since the slot was loaded: decode the file again the way the loader did,
+        // so the spectrum starts from exactly what the slot holds. Slots never edited keep one copy.
+        if (spectrumSerials[(size_t)slotIndex] != serial)
+        {
+            spectrum.clear();
+            slotPromotions[(size_t)slotIndex].clear();
+            spectrumSerials[(size_t)slotIndex] = serial;
+
+            ForgeProcessor::PreparedSample decoded;
+            if (forgeProcessor.prepareSample(file, decoded))
+            {
+                juce::AudioBuffer<float> audio(decoded.storage.getNumChannels(), decoded.storage.getNumSamples());
+                for (int ch = 0; ch < audio.getNumChannels(); ++ch)
+                    decoded.storage.readWindow(ch, 0, audio.getNumSamples(), audio.getWritePointer(ch));
+
+                // int16 clips anything boosted past full scale; the first splice moves the slot to a format that doesn't
+                const bool promote = decoded.storage.getFormat() == SampleStorage::Format::Int16;
+                decoded.storage.clear();
+                if (promote)
+                {
+                    const bool compact = forgeProcessor.getSampleStorageMode() == ForgeProcessor::SampleStorageMode::Compact;
+                    slotPromotions[(size_t)slotIndex].setFrom(audio, compact ? SampleStorage::Format::Half
+                                                                             : SampleStorage::Format::Float32);
+                }
+
+                // Brush y follows the rows of requestSlotAnalysis' canvas
+                const SpectrogramAnalyzer::Settings canvasLayout;
+                spectrum.setSource(std::move(audio), decoded.sampleRate, canvasLayout.minFreq, canvasLayout.maxFreq);
+            }
+        }
+
+        spectrum.applyBrush(brush);
+
+        // Dabs queue up faster than a resynthesis; only the last of a run pays for it
+        if (--pendingSpectralEdits == 0)
+            flushSpectralEdits();
+    });
+
+    return true;
+}
+
+void ARTEFACTAudioProcessor::flushSpectralEdits()
+{
+    for (int slot = 0; slot < (int)slotSpectra.size(); ++slot)
+    {
+        auto& spectrum = slotSpectra[(size_t)slot];
+        auto samples = spectrum.takeDirtySamples();
+
+        while (!samples.isEmpty())
+        {
+            // The audio thread hands entries back as it applies them; give up if it isn't running
+            auto handle = splicePayloads.acquire();
+            while (!handle.isValid() && spliceRetired.wait(spliceWaitMs))
+                handle = splicePayloads.acquire();
+
+            if (!handle.isValid())
+                break;
+
+            auto& splice = splicePayloads.get(handle);
+            const int num = juce::jmin(samples.getLength(), ForgeProcessor::maxSpliceSamples);
+            splice.audio.setSize(spectrum.getNumChannels(), num);
+            spectrum.render(samples.getStart(), splice.audio, num);
+            splice.startSample = samples.getStart();
+            splice.serial = spectrumSerials[(size_t)slot];
+            std::swap(splice.storage, slotPromotions[(size_t)slot]);
+
+            if (!pushCommandFrom(sampleEditorProducer, Command(ForgeCommandID::SpliceSample, slot, handle)))
+            {
+                std::swap(splice.storage, slotPromotions[(size_t)slot]);
+                splicePayloads.cancel(handle);
+                break;
+            }
+
+            samples.setStart(samples.getStart() + num);
+        }
+
+        // Whatever didn't go out goes with the next edit
+        spectrum.markDirty(samples);
+    }
+}
+
+bool ARTEFACTAudioProcessor::pushStrokeSegment(const StrokeSegment& segment)
+{
+    if (segment.isEmpty())
+        return true;
+
+    const auto handle = strokeSegmentPayloads.acquire();
+    if (!handle.isValid())
+        return false;
+
+    strokeSegmentPayloads.get(handle) = segment;
+    if (!pushCommandToQueue(Command(PaintCommandID::StrokeSegment, handle)))
+    {
+        strokeSegmentPayloads.cancel(handle);
+        return false;
+    }
+
+    return true;
+}
+
+// Commands are played back one block late, at the offset matching how long after
+// the previous block started they were issued. That keeps gesture timing intact
+// at any buffer size instead of snapping everything to block boundaries.
+int ARTEFACTAudioProcessor::getCommandOffset(const Command& cmd, int numSamples) const
+{
+    if (cmd.timestamp == 0 || previousBlockTicks == 0 || isNonRealtime())
+        return 0;
+
+    const double seconds = juce::Time::highResolutionTicksToSeconds(cmd.timestamp - previousBlockTicks);
+    return juce::jlimit(0, juce::jmax(0, numSamples - 1), static_cast<int>(seconds * currentSampleRate));
+}
+
+void ARTEFACTAudioProcessor::processForgeCommand(const Command& cmd)
+{
+    switch (cmd.getForgeCommandID())
+    {
+    case ForgeCommandID::StartPlayback:
+        forgeProcessor.getVoice(cmd.intParam).start();
+        break;
+    case ForgeCommandID::StopPlayback:
+        forgeProcessor.getVoice(cmd.intParam).stop();
+        break;
+    case ForgeCommandID::LoadSample:
+        forgeProcessor.installSample(cmd.intParam, samplePayloads.get(cmd.payload));
+        samplePayloads.retire(cmd.payload);
+        break;
+    case ForgeCommandID::SpliceSample:
+        forgeProcessor.spliceSample(cmd.intParam, splicePayloads.get(cmd.payload));
+        splicePayloads.retire(cmd.payload);
+        spliceRetired.signal();
+        break;
+    case ForgeCommandID::SetPitch:
+        forgeProcessor.getVoice(cmd.intParam).setPitch(cmd.value.floatParam);
+        break;
+    case ForgeCommandID::SetSpeed:
+        forgeProcessor.getVoice(cmd.intParam).setSpeed(cmd.value.floatParam);
+        break;
+    case ForgeCommandID::SetVolume:
+        forgeProcessor.getVoice(cmd.intParam).setVolume(cmd.value.floatParam);
+        break;
+    case ForgeCommandID::SetDrive:
+        forgeProcessor.getVoice(cmd.intParam).setDrive(cmd.value.floatParam);
+        break;
+    case ForgeCommandID::SetCrush:
+        forgeProcessor.getVoice(cmd.intParam).setCrush(cmd.value.floatParam);
+        break;
+    case ForgeCommandID::SetSyncMode:
+        forgeProcessor.getVoice(cmd.intParam).setSyncMode(cmd.value.boolParam);
+        break;
+    case ForgeCommandID::LoadCanvasImage:
+        canvasProcessor.installImage(canvasImagePayloads.get(cmd.payload));
+        canvasImagePayloads.retire(cmd.payload);
+        break;
+    case ForgeCommandID::SetCanvasPlayhead:
+        canvasProcessor.setPlayheadPosition(cmd.value.floatParam);
+        break;
+    case ForgeCommandID::SetCanvasActive:
+        canvasProcessor.setActive(cmd.value.boolParam);
+        break;
+    case ForgeCommandID::SetCanvasFreqRange:
+        canvasProcessor.setFrequencyRange(cmd.value.floatParam, cmd.value.floatParam2);
+        break;
+    case ForgeCommandID::SetCanvasSweepDuration:
+        canvasProcessor.setSweepDuration(cmd.value.floatParam);
+        break;
+    case ForgeCommandID::SetInterpolation:
+        forgeProcessor.getVoice(cmd.intParam).setInterpolation(
+            static_cast<ForgeVoice::Interpolation>(juce::jlimit(0, 2, static_cast<int>(cmd.value.floatParam))));
+        break;
+    case ForgeCommandID::SetStretchMode:
+        forgeProcessor.getVoice(cmd.intParam).setStretchMode(
+            static_cast<ForgeVoice::StretchMode>(juce::jlimit(0, 2, static_cast<int>(cmd.value.floatParam))));
+        break;
+    default:
+        break;
+    }
+}
+
+void ARTEFACTAudioProcessor::processPaintCommand(const Command& cmd)
+{
+    switch (cmd.getPaintCommandID())
+    {
+    case PaintCommandID::BeginStroke:
+        paintEngine.beginStroke(PaintEngine::Point(cmd.stroke.x, cmd.stroke.y), cmd.stroke.pressure, cmd.getColour());
+        break;
+    case PaintCommandID::UpdateStroke:
+        paintEngine.updateStroke(PaintEngine::Point(cmd.stroke.x, cmd.stroke.y), cmd.stroke.pressure);
+        break;
+    case PaintCommandID::StrokeSegment:
+    {
+        const auto& segment = strokeSegmentPayloads.get(cmd.payload);
+        std::array<PaintEngine::Point, StrokeSegment::maxPoints> positions;
+        for (int i = 0; i < segment.numPoints; ++i)
+            positions[(size_t)i] = PaintEngine::Point(segment.x[(size_t)i], segment.y[(size_t)i]);
+
+        paintEngine.updateStroke(positions.data(), segment.pressure.data(), segment.numPoints);
+        strokeSegmentPayloads.retire(cmd.payload);
+        break;
+    }
+    case PaintCommandID::EndStroke:
+        paintEngine.endStroke();
+        break;
+    case PaintCommandID::ClearCanvas:
+        paintEngine.clearCanvas();
+        break;
+    case PaintCommandID::SetPlayheadPosition:
+        paintEngine.setPlayheadPosition(cmd.value.floatParam);
+        break;
+    case PaintCommandID::SetPaintActive:
+        paintEngine.setActive(cmd.value.boolParam);
+        break;
+    case PaintCommandID::SetMasterGain:
+        paintEngine.setMasterGain(cmd.value.floatParam);
+        break;
+    case PaintCommandID::SetFrequencyRange:
+        paintEngine.setFrequencyRange(cmd.value.floatParam, cmd.value.floatParam2);
+        break;
+    case PaintCommandID::SetCanvasRegion:
+        paintEngine.setCanvasRegion(cmd.region.x, cmd.region.y, cmd.region.width, cmd.region.height);
+        break;
+    default:
+        break;
+    }
+}
+
+void ARTEFACTAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
+{
+    juce::ScopedNoDenormals noDenormals;
+
+    const auto blockTicks = juce::Time::getHighResolutionTicks();
+    const int numSamples = buffer.getNumSamples();
+
+    // Update BPM if available from host
+    if (auto playHead = getPlayHead())
+    {
+        if (auto positionInfo = playHead->getPosition())
+        {
+            if (positionInfo->getBpm().hasValue())
+            {
+                double hostBPM = *positionInfo->getBpm();
+                if (std::abs(hostBPM - lastKnownBPM) > 0.1)
+                {
+                    lastKnownBPM = hostBPM;
+                    forgeProcessor.setHostBPM(hostBPM);
+                }
+            }
+        }
+    }
+
+    // Render up to each due command, then apply it. Commands issued after
+    // this block started wait for the next one.
+    const int numDue = gatherDueCommands(blockTicks);
+    int rendered = 0;
+
+    for (int i = 0; i < numDue; ++i)
+    {
+        const auto& cmd = pendingCommands[(size_t)i];
+        const int offset = juce::jmax(rendered, getCommandOffset(cmd, numSamples));
+        renderSegment(buffer, midi, rendered, offset - rendered);
+        rendered = offset;
+
+        applyCommand(cmd);
+    }
+
+    pendingCommands.erase(pendingCommands.begin(), pendingCommands.begin() + numDue);
+    renderSegment(buffer, midi, rendered, numSamples - rendered);
+    previousBlockTicks = blockTicks;
+
+    processSpectralInsert(buffer, numSamples);
+    publishTelemetry(buffer, blockTicks);
+}
+
+void ARTEFACTAudioProcessor::processSpectralInsert(juce::AudioBuffer<float>& buffer, int numSamples)
+{
+    const bool spectralOn = spectralActive.load();
+
+    if (!spectralRunning)
+    {
+        if (!spectralOn)
+            return;
+
+        // Starts from silence each time, so it only fades in once its first frame is out
+        spectralProcessor.reset();
+        spectralWarmup = spectralProcessor.getLatencySamples();
+        spectralRunning = true;
+    }
+
+    if (spectralWarmup <= 0)
+    {
+        spectralMix.setTargetValue(spectralOn ? 1.0f : 0.0f);
+    }
+    else if (!spectralOn)
+    {
+        // Switched off before anything was heard
+        spectralRunning = false;
+        return;
+    }
+
+    spectralProcessor.spectralShift(spectralShift.load());
+    spectralProcessor.spectralStretch(spectralStretch.load());
+
+    const int numChannels = juce::jmin(buffer.getNumChannels(), spectralWet.getNumChannels());
+
+    for (int start = 0; start < numSamples;)
+    {
+        const int num = juce::jmin(spectralWet.getNumSamples(), numSamples - start);
+        spectralProcessor.analyzeBuffer(buffer, start, num);
+        spectralProcessor.resynthesizeToBuffer(spectralWet, 0, num);
+
+        const float wetStart = spectralMix.getCurrentValue();
+        spectralMix.skip(num);
+        const float wetEnd = spectralMix.getCurrentValue();
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            buffer.applyGainRamp(ch, start, num, 1.0f - wetStart, 1.0f - wetEnd);
+            buffer.addFromWithRamp(ch, start, spectralWet.getReadPointer(ch), num, wetStart, wetEnd);
+        }
+
+        start += num;
+    }
+
+    spectralWarmup -= numSamples;
+
+    // Faded all the way out
+    if (!spectralOn && !spectralMix.isSmoothing())
+        spectralRunning = false;
+}
+
+void ARTEFACTAudioProcessor::publishTelemetry(const juce::AudioBuffer<float>& buffer, juce::int64 blockTicks)
+{
+    auto& snapshot = parameterBridge.beginWrite();
+
+    std::array<float, 8> levels;
+    std::array<int, 8> activeNotes;
+    forgeProcessor.takeSlotLevels(levels, activeNotes);
+
+    for (int i = 0; i < ParameterBridge::numSlots; ++i)
+    {
+        const auto& voice = forgeProcessor.getVoice(i);
+        auto& slot = snapshot.slots[(size_t)i];
+        slot.progress = voice.getProgress();
+        slot.level = levels[(size_t)i];
+        slot.activeNotes = activeNotes[(size_t)i];
+        slot.isPlaying = voice.isActive();
+        slot.hasSample = voice.hasSample();
+        slot.sampleMemoryKB = (int)(voice.getSampleMemoryBytes() / 1024);
+        slot.memorySavedKB = (int)(voice.getSampleMemorySaved() / 1024);
+    }
+
+    const int numSamples = buffer.getNumSamples();
+    for (int ch = 0; ch < 2; ++ch)
+        snapshot.outputLevel[(size_t)ch] = ch < buffer.getNumChannels() ? buffer.getMagnitude(ch, 0, numSamples) : 0.0f;
+
+    snapshot.activePartials = paintEngine.getActiveOscillatorCount();
+
+    const double blockSeconds = numSamples / currentSampleRate;
+
+    for (int i = 0; i < juce::jmin(engineGraph.getNumNodes(), ParameterBridge::maxEngines); ++i)
+    {
+        auto& engine = snapshot.engines[(size_t)i];
+        engine.cpuLoad = engineGraph.takeNodeCpuLoad(i, blockSeconds);
+        engine.asleep = engineGraph.isNodeAsleep(i);
+    }
+
+    const double elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - blockTicks);
+    snapshot.cpuLoad = blockSeconds > 0.0 ? (float)(elapsed / blockSeconds) : 0.0f;
+
+    parameterBridge.publish();
+}
+
+void ARTEFACTAudioProcessor::renderSegment(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi,
+                                           int startSample, int numSamples)
+{
+    if (numSamples <= 0)
+        return;
+
+    // Disabled and idle engines are skipped; the rest render in parallel
+    engineGraph.process(buffer, midi, startSample, numSamples);
+}
+
+//==============================================================================
+// Plugin Factory
+
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
+{
+    return new ARTEFACTAudioProcessor();
+}
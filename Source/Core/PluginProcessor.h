@@ -1,70 +1,171 @@
-﻿// Source/PluginProcessor.h
-#pragma once
-
-#include <JuceHeader.h>
-#include "Core/Commands.h"
-#include "Core/ForgeProcessor.h"
-#include "Core/PaintEngine.h"
-#include "Core/ParameterBridge.h"
-
-class ARTEFACTAudioProcessor : public juce::AudioProcessor,
-    public juce::AudioProcessorValueTreeState::Listener
-{
-public:
-    ARTEFACTAudioProcessor();
-    ~ARTEFACTAudioProcessor() override;
-
-    void prepareToPlay(double, int) override;
-    void releaseResources() override {}
-    void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
-    bool isBusesLayoutSupported(const BusesLayout&) const override;
-
-    juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override { return true; }
-
-    const juce::String getName() const override { return JucePlugin_Name; }
-    bool acceptsMidi() const override { return true; }
-    bool producesMidi() const override { return false; }
-    bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
-
-    int getNumPrograms() override { return 1; }
-    int getCurrentProgram() override { return 0; }
-    void setCurrentProgram(int) override {}
-    const juce::String getProgramName(int) override { return {}; }
-    void changeProgramName(int, const juce::String&) override {}
-
-    void getStateInformation(juce::MemoryBlock&) override {}
-    void setStateInformation(const void*, int) override {}
-
-    bool pushCommandToQueue(const Command& newCommand);
-
-    void parameterChanged(const juce::String&, float) override;
-    
-    // Accessors for GUI
-    ForgeProcessor& getForgeProcessor() { return forgeProcessor; }
-    PaintEngine& getPaintEngine() { return paintEngine; }
-
-private:
-    static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
-    juce::AudioProcessorValueTreeState apvts;
-
-    ForgeProcessor  forgeProcessor;
-    PaintEngine paintEngine;
-    ParameterBridge parameterBridge;
-
-    enum class ProcessingMode { Forge = 0, Canvas, Hybrid };
-    ProcessingMode currentMode = ProcessingMode::Forge;
-
-    static constexpr int fifoSize = 256;
-    juce::AbstractFifo             abstractFifo{ fifoSize };
-    std::array<Command, fifoSize>  commandFIFO;
-    void processNextCommand();
-    void processForgeCommand(const Command& cmd);
-    void processPaintCommand(const Command& cmd);
-
-    double lastKnownBPM = 120.0;
-    double currentSampleRate = 44100.0;
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ARTEFACTAudioProcessor)
-};
+﻿// Source/PluginProcessor.h
+#pragma once
+
+#include <JuceHeader.h>
+#include "Core/Commands.h"
+#include "Core/CommandQueue.h"
+#include "Core/MpscCommandQueue.h"
+#include "Core/ForgeProcessor.h"
+#include "Core/PaintEngine.h"
+#include "Core/ParameterBridge.h"
+#include "Core/CanvasProcessor.h"
+#include "Core/SpectrogramAnalyzer.h"
+#include "Core/SpectralProcessor.h"
+#include "Core/SampleSpectrum.h"
+#include "Core/EngineGraph.h"
+#include "Core/PayloadPool.h"
+#include "Core/WakeSignal.h"
+
+class ARTEFACTAudioProcessor : public juce::AudioProcessor,
+    public juce::AudioProcessorValueTreeState::Listener,
+    private juce::Timer,
+    private juce::AsyncUpdater
+{
+public:
+    ARTEFACTAudioProcessor();
+    ~ARTEFACTAudioProcessor() override;
+
+    void prepareToPlay(double, int) override;
+    void releaseResources() override {}
+    void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    bool isBusesLayoutSupported(const BusesLayout&) const override;
+
+    juce::AudioProcessorEditor* createEditor() override;
+    bool hasEditor() const override { return true; }
+
+    const juce::String getName() const override { return JucePlugin_Name; }
+    bool acceptsMidi() const override { return true; }
+    bool producesMidi() const override { return false; }
+    bool isMidiEffect() const override { return false; }
+    double getTailLengthSeconds() const override { return 0.0; }
+
+    int getNumPrograms() override { return 1; }
+    int getCurrentProgram() override { return 0; }
+    void setCurrentProgram(int) override {}
+    const juce::String getProgramName(int) override { return {}; }
+    void changeProgramName(int, const juce::String&) override {}
+
+    void getStateInformation(juce::MemoryBlock&) override {}
+    void setStateInformation(const void*, int) override {}
+
+    bool pushCommandToQueue(const Command& newCommand);
+    void flushPendingCommands();
+
+    // For threads other than the editor's (file watchers, loaders, listeners).
+    // Register once per thread, then push with the returned id from that thread.
+    int registerCommandProducer();
+    bool pushCommandFrom(int producerId, const Command& newCommand);
+    CommandQueue<256>::Stats getCommandQueueStats() const { return commandQueue.getStats(); }
+
+    // Message thread: decodes the file on a background thread, which then hands the sample
+    // to the audio thread. False when every sample slot is still in flight.
+    bool requestSampleLoad(int slotIndex, const juce::File& file);
+
+    // Message thread: queues the image for conversion on a background thread, which then
+    // hands it to the audio thread. The image is read there, so don't draw into it afterwards.
+    // False when every image slot is still in flight.
+    bool requestCanvasImage(const juce::Image& image);
+    // Message thread: streams the canvas from a tile file (see CanvasTileWriter) instead
+    bool requestTiledCanvas(const juce::File& tileFile);
+
+    // Message thread: renders the slot's sample into the canvas on a background thread and
+    // sets the canvas to play it back at its own length. False without a sample or a free image slot.
+    bool requestSlotAnalysis(int slotIndex);
+
+    // Message thread: paints one brush dab on the slot sample's spectrum, in the coordinates of
+    // its analysis canvas. The spectrum is analysed on a background thread as dabs reach it, and
+    // the edited stretch is resynthesised and spliced into the slot once the dabs queued so far
+    // are in. False without a sample.
+    bool requestSpectralEdit(int slotIndex, const SampleSpectrum::Brush& brush);
+
+    // Editor thread; false when every segment slot is still in flight
+    bool pushStrokeSegment(const StrokeSegment& segment);
+
+    void parameterChanged(const juce::String&, float) override;
+    
+    // Accessors for GUI
+    ForgeProcessor& getForgeProcessor() { return forgeProcessor; }
+    PaintEngine& getPaintEngine() { return paintEngine; }
+    // Per-block meters and playheads; read from the GUI thread only
+    ParameterBridge& getParameterBridge() { return parameterBridge; }
+
+private:
+    static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
+    juce::AudioProcessorValueTreeState apvts;
+
+    ForgeProcessor  forgeProcessor;
+    PaintEngine paintEngine;
+    CanvasProcessor canvasProcessor;
+    EngineGraph     engineGraph;        // renders the engines above, in parallel where it can
+    int forgeNode = -1, paintNode = -1, canvasNode = -1;
+    ParameterBridge parameterBridge;
+
+    // Which engine nodes are switched on and how loud
+    enum class ProcessingMode { Forge = 0, Canvas, Hybrid };
+    ProcessingMode currentMode = ProcessingMode::Forge;
+    void updateEngineRouting();
+
+    CommandQueue<256>              commandQueue;         // editor -> audio
+    MpscCommandQueue<1024, 8>      sharedCommandQueue;   // any other thread -> audio
+    std::vector<Command>           pendingCommands;      // drained, waiting for their offset
+    PayloadPool<ForgeProcessor::PreparedSample, 8> samplePayloads;
+    PayloadPool<StrokeSegment, 16>                 strokeSegmentPayloads;
+    PayloadPool<CanvasProcessor::PreparedImage, 4> canvasImagePayloads;
+    PayloadPool<ForgeProcessor::PreparedSplice, 8> splicePayloads;        // acquired on sampleEditor's thread
+    void timerCallback() override;
+    void handleAsyncUpdate() override;   // reports the spectral insert's latency
+    void applyCommand(const Command& cmd);
+    int gatherDueCommands(juce::int64 blockTicks);
+    int getCommandOffset(const Command& cmd, int numSamples) const;
+    void renderSegment(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi, int startSample, int numSamples);
+    void processForgeCommand(const Command& cmd);
+    void processPaintCommand(const Command& cmd);
+    void publishTelemetry(const juce::AudioBuffer<float>& buffer, juce::int64 blockTicks);
+    void processSpectralInsert(juce::AudioBuffer<float>& buffer, int numSamples);
+
+    double lastKnownBPM = 120.0;
+    double currentSampleRate = 44100.0;
+    juce::int64 previousBlockTicks = 0;     // when the last processBlock started
+    std::atomic<float> hybridBalance{ 0.25f };   // 0 = Forge only, 1 = Paint only
+
+    SpectralProcessor spectralProcessor;         // master insert, audio thread
+    std::atomic<bool>  spectralActive{ false };
+    std::atomic<float> spectralShift{ 0.0f };    // semitones
+    std::atomic<float> spectralStretch{ 1.0f };
+    // The rest are the audio thread's. The insert fades in and out against the dry mix.
+    bool spectralRunning = false;
+    int spectralWarmup = 0;                      // samples until the insert's first frame is out
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> spectralMix;
+    juce::AudioBuffer<float> spectralWet;
+    static constexpr double spectralFadeSeconds = 0.02;
+
+    std::array<juce::File, 8> slotFiles;          // what each slot was loaded from, under slotFilesLock
+    std::array<juce::uint32, 8> slotSerials{};    // PreparedSample::serial of each slot's load, likewise
+    juce::SpinLock slotFilesLock;                 // background threads and the message thread; never the audio thread
+    juce::uint32 nextSampleSerial = 0;            // message thread
+    bool getSlotSource(int slotIndex, juce::File& file, juce::uint32& serial) const;
+    SpectrogramAnalyzer spectrogramAnalyzer;      // canvasImageLoader's thread only
+    static constexpr juce::int64 maxInMemoryCanvasBytes = 64 * 1024 * 1024;   // longer renders go to tiles
+
+    // Converts canvas images off the message thread. One thread, so one command producer.
+    // Declared last so its jobs finish before the pools and queues they use go away.
+    juce::ThreadPool canvasImageLoader{ 1 };
+    int canvasImageProducer = -1;
+
+    // Decodes dropped samples; one thread, so loads into a slot arrive in the order they were asked for
+    juce::ThreadPool sampleLoader{ 1 };
+    int sampleLoaderProducer = -1;
+
+    // Spectral edits, on their own thread so a slot analysis doesn't hold up painting
+    std::array<SampleSpectrum, 8> slotSpectra;        // sampleEditor's thread only
+    std::array<juce::uint32, 8> spectrumSerials{};   // the load each spectrum was analysed from
+    std::array<SampleStorage, 8> slotPromotions;      // an int16 slot re-encoded to hold boosts, sent with its first splice
+    std::atomic<int> pendingSpectralEdits{ 0 };
+    WakeSignal spliceRetired;                         // posted by the audio thread each time it hands a splice back
+    static constexpr int spliceWaitMs = 500;          // without one, the audio thread isn't running
+    void flushSpectralEdits();
+    juce::ThreadPool sampleEditor{ 1 };
+    int sampleEditorProducer = -1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ARTEFACTAudioProcessor)
+};
@@ -0,0 +1,309 @@
+// Core/SampleSpectrum.cpp
+#include "SampleSpectrum.h"
+#include "SampleStorage.h"
+#include <cmath>
+
+SampleSpectrum::SampleSpectrum()
+{
+    // Periodic, so the squares of frames half a frame apart sum to exactly one
+    window.resize((size_t)fftSize);
+    for (int i = 0; i < fftSize; ++i)
+        window[(size_t)i] = std::sin(juce::MathConstants<float>::pi * (float)i / (float)fftSize);
+
+    fftData.assign((size_t)fftSize * 2, 0.0f);
+}
+
+void SampleSpectrum::setSource(juce::AudioBuffer<float>&& audio, double newSampleRate, float newMinFreq, float newMaxFreq)
+{
+    source = std::move(audio);
+    numSamples = source.getNumSamples();
+    sampleRate = newSampleRate > 0.0 ? newSampleRate : 44100.0;
+    minFreq = newMinFreq;
+    maxFreq = newMaxFreq;
+
+    frames.clear();
+    frames.resize((size_t)getNumFrames());
+    edited.assign((size_t)getNumFrames(), false);
+    dirtyFrames = {};
+
+    const size_t frameValues = (size_t)getNumChannels() * (size_t)numBins * 2;
+    previous.assign(frameValues, 0.0f);
+    current.assign(frameValues, 0.0f);
+    next.assign(frameValues, 0.0f);
+    result.assign(frameValues, 0.0f);
+
+    // The canvas row law: y = 1 at minFreq, 0 at maxFreq. DC sits below the canvas.
+    const float logMin = std::log(minFreq);
+    const float logRange = std::log(maxFreq) - logMin;
+    binY.resize((size_t)numBins);
+    binY[0] = 2.0f;
+    for (int k = 1; k < numBins; ++k)
+        binY[(size_t)k] = 1.0f - (std::log((float)(k * sampleRate / fftSize)) - logMin) / logRange;
+}
+
+void SampleSpectrum::clear()
+{
+    source.setSize(0, 0);
+    numSamples = 0;
+    frames.clear();
+    edited.clear();
+    dirtyFrames = {};
+}
+
+//==============================================================================
+void SampleSpectrum::applyBrush(const Brush& brush)
+{
+    if (isEmpty())
+        return;
+
+    const int numChannels = getNumChannels();
+    const int stride = numBins * 2;
+    const float framesPerX = (float)numSamples / (float)hopSize;
+
+    // Never narrower than a hop, so every dab reaches at least one frame
+    const float radiusX = juce::jmax(brush.radiusX, 1.0f / framesPerX);
+    const float radiusY = juce::jmax(brush.radiusY, 1.0e-4f);
+
+    const int firstFrame = juce::jmax(0, (int)std::ceil((brush.x - radiusX) * framesPerX));
+    const int lastFrame = juce::jmin(getNumFrames() - 1, (int)std::floor((brush.x + radiusX) * framesPerX));
+    if (firstFrame > lastFrame)
+        return;
+
+    // Bins the dab can reach; y grows downwards, towards minFreq
+    const float logMin = std::log(minFreq);
+    const float logRange = std::log(maxFreq) - logMin;
+    const double binHz = sampleRate / fftSize;
+    const double lowHz = std::exp(logMin + (1.0f - (brush.y + radiusY)) * logRange);
+    const double highHz = std::exp(logMin + (1.0f - (brush.y - radiusY)) * logRange);
+    const int firstBin = juce::jlimit(1, numBins - 1, (int)std::floor(lowHz / binHz));
+    const int lastBin = juce::jlimit(1, numBins - 1, (int)std::ceil(highHz / binHz));
+
+    const float amount = juce::jlimit(0.0f, 1.0f, brush.amount);
+    const bool smear = brush.mode == Brush::Mode::Smear;
+
+    // Smearing reads each frame's neighbours as they were before this dab
+    bool hasPrevious = false;
+    if (smear && firstFrame > 0)
+    {
+        ensureFrame(firstFrame - 1);
+        decodeFrame(firstFrame - 1, previous.data());
+        hasPrevious = true;
+    }
+
+    ensureFrame(firstFrame);
+    decodeFrame(firstFrame, current.data());
+
+    for (int f = firstFrame; f <= lastFrame; ++f)
+    {
+        const bool hasNext = smear && f + 1 < getNumFrames();
+        if (hasNext)
+        {
+            ensureFrame(f + 1);
+            decodeFrame(f + 1, next.data());
+        }
+
+        std::copy(current.begin(), current.end(), result.begin());
+        const float dx = ((float)f / framesPerX - brush.x) / radiusX;
+
+        for (int k = firstBin; k <= lastBin; ++k)
+        {
+            const float dy = (binY[(size_t)k] - brush.y) / radiusY;
+            const float distance = dx * dx + dy * dy;
+            if (distance >= 1.0f)
+                continue;
+
+            const float weight = amount * (0.5f + 0.5f * std::cos(juce::MathConstants<float>::pi * std::sqrt(distance)));
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                const size_t offset = (size_t)ch * (size_t)stride;
+                float* bin = result.data() + offset + (size_t)k * 2;
+
+                switch (brush.mode)
+                {
+                case Brush::Mode::Erase:
+                    bin[0] *= 1.0f - weight;
+                    bin[1] *= 1.0f - weight;
+                    break;
+
+                case Brush::Mode::Boost:
+                    bin[0] *= 1.0f + (maxBoost - 1.0f) * weight;
+                    bin[1] *= 1.0f + (maxBoost - 1.0f) * weight;
+                    break;
+
+                case Brush::Mode::Smear:
+                {
+                    // Mean magnitude over the 3x3 neighbourhood; the bin keeps its phase
+                    float sum = 0.0f;
+                    int count = 0;
+                    for (const auto* frame : { hasPrevious ? previous.data() : nullptr, current.data(),
+                                               hasNext ? next.data() : nullptr })
+                    {
+                        if (frame == nullptr)
+                            continue;
+
+                        for (int j = k - 1; j <= juce::jmin(k + 1, numBins - 1); ++j)
+                        {
+                            const float* z = frame + offset + (size_t)j * 2;
+                            sum += std::sqrt(z[0] * z[0] + z[1] * z[1]);
+                            ++count;
+                        }
+                    }
+
+                    const float magnitude = std::sqrt(bin[0] * bin[0] + bin[1] * bin[1]);
+                    const float target = magnitude + weight * (sum / (float)count - magnitude);
+
+                    if (magnitude > 1.0e-12f)
+                    {
+                        bin[0] *= target / magnitude;
+                        bin[1] *= target / magnitude;
+                    }
+                    else
+                    {
+                        bin[0] = target;
+                    }
+                    break;
+                }
+                }
+            }
+        }
+
+        encodeFrame(f, result.data());
+        edited[(size_t)f] = true;
+
+        if (smear)
+        {
+            std::swap(previous, current);
+            std::swap(current, next);
+            hasPrevious = true;
+        }
+        else if (f < lastFrame)
+        {
+            ensureFrame(f + 1);
+            decodeFrame(f + 1, current.data());
+        }
+    }
+
+    addDirtyFrames(firstFrame, lastFrame);
+}
+
+//==============================================================================
+juce::Range<int> SampleSpectrum::takeDirtySamples()
+{
+    if (dirtyFrames.isEmpty())
+        return {};
+
+    // Frame f covers [f - 1, f + 1) hops
+    const juce::Range<int> samples(getFrameStart(dirtyFrames.getStart()), getFrameStart(dirtyFrames.getEnd()) + hopSize);
+    dirtyFrames = {};
+    return samples.getIntersectionWith({ 0, numSamples });
+}
+
+void SampleSpectrum::markDirty(juce::Range<int> samples)
+{
+    samples = samples.getIntersectionWith({ 0, numSamples });
+    if (samples.isEmpty())
+        return;
+
+    addDirtyFrames(samples.getStart() / hopSize,
+                   juce::jmin(getNumFrames() - 1, (samples.getEnd() - 1) / hopSize + 1));
+}
+
+void SampleSpectrum::addDirtyFrames(int first, int last)
+{
+    const juce::Range<int> range(first, last + 1);
+    dirtyFrames = dirtyFrames.isEmpty() ? range : dirtyFrames.getUnionWith(range);
+}
+
+//==============================================================================
+void SampleSpectrum::render(int startSample, juce::AudioBuffer<float>& dest, int numToRender)
+{
+    jassert(startSample >= 0 && startSample + numToRender <= numSamples);
+    jassert(dest.getNumChannels() >= getNumChannels() && dest.getNumSamples() >= numToRender);
+
+    const int numChannels = getNumChannels();
+    const int stride = numBins * 2;
+    const int endSample = startSample + numToRender;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        juce::FloatVectorOperations::copy(dest.getWritePointer(ch), source.getReadPointer(ch, startSample), numToRender);
+
+    // The original is every frame overlap-added untouched; swap in each edited frame's difference
+    const int lastFrame = juce::jmin(getNumFrames() - 1, (endSample - 1) / hopSize + 1);
+
+    for (int f = startSample / hopSize; f <= lastFrame; ++f)
+    {
+        if (!edited[(size_t)f])
+            continue;
+
+        const int frameStart = getFrameStart(f);
+        const int from = juce::jmax(startSample, frameStart);
+        const int to = juce::jmin(endSample, frameStart + fftSize);
+        if (from >= to)
+            continue;
+
+        decodeFrame(f, current.data());
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            float* frame = fftData.data();
+            float* original = fftData.data() + fftSize;
+
+            juce::FloatVectorOperations::multiply(frame, current.data() + (size_t)ch * (size_t)stride, (float)fftSize, stride);
+            fft.performRealOnlyInverseTransform(frame);
+
+            readFrame(ch, f, original);
+            juce::FloatVectorOperations::subtract(frame, original, fftSize);
+            juce::FloatVectorOperations::multiply(frame, window.data(), fftSize);
+            juce::FloatVectorOperations::add(dest.getWritePointer(ch, from - startSample), frame + (from - frameStart), to - from);
+        }
+    }
+}
+
+//==============================================================================
+void SampleSpectrum::readFrame(int channel, int frame, float* dest) const
+{
+    const int frameStart = getFrameStart(frame);
+    const int from = juce::jmax(0, frameStart);
+    const int to = juce::jmin(numSamples, frameStart + fftSize);
+
+    juce::FloatVectorOperations::clear(dest, fftSize);
+    if (from < to)
+        juce::FloatVectorOperations::copy(dest + (from - frameStart), source.getReadPointer(channel, from), to - from);
+
+    juce::FloatVectorOperations::multiply(dest, window.data(), fftSize);
+}
+
+void SampleSpectrum::ensureFrame(int frame)
+{
+    auto& stored = frames[(size_t)frame];
+    if (!stored.empty())
+        return;
+
+    const int stride = numBins * 2;
+    stored.resize((size_t)getNumChannels() * (size_t)stride);
+
+    for (int ch = 0; ch < getNumChannels(); ++ch)
+    {
+        readFrame(ch, frame, fftData.data());
+        juce::FloatVectorOperations::clear(fftData.data() + fftSize, fftSize);
+        fft.performRealOnlyForwardTransform(fftData.data(), true);
+
+        juce::FloatVectorOperations::multiply(fftData.data(), 1.0f / (float)fftSize, stride);
+        juce::FloatVectorOperations::clip(fftData.data(), fftData.data(), -maxStored, maxStored, stride);
+        SampleStorage::encodeHalf(fftData.data(), stored.data() + (size_t)ch * (size_t)stride, stride);
+    }
+}
+
+void SampleSpectrum::decodeFrame(int frame, float* dest) const
+{
+    const auto& stored = frames[(size_t)frame];
+    SampleStorage::decodeHalf(stored.data(), dest, (int)stored.size());
+}
+
+void SampleSpectrum::encodeFrame(int frame, float* bins)
+{
+    auto& stored = frames[(size_t)frame];
+    juce::FloatVectorOperations::clip(bins, bins, -maxStored, maxStored, (int)stored.size());
+    SampleStorage::encodeHalf(bins, stored.data(), (int)stored.size());
+}
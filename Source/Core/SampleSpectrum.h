@@ -0,0 +1,95 @@
+// Core/SampleSpectrum.h
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+//==============================================================================
+// An editable STFT of one slot's sample, for the spectral brushes.
+//
+// Frames are analysed the first time a brush reaches them and cached as half
+// floats, so a multi-minute file costs nothing until it is painted on and
+// then only as much as has been touched. Square-root Hann frames at 50%
+// overlap reconstruct exactly; resynthesis starts from the original audio and
+// adds what each edited frame changes, so untouched frames are never
+// transformed and only the samples under edited frames are recomputed.
+//
+// Not thread-safe; one background thread owns each spectrum.
+class SampleSpectrum
+{
+public:
+    static constexpr int fftOrder = 11;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int hopSize = fftSize / 2;
+    static constexpr int numBins = fftSize / 2 + 1;
+
+    // One dab, in the coordinates of the slot's analysis canvas
+    struct Brush
+    {
+        enum class Mode
+        {
+            Erase = 0,   // towards silence
+            Boost,       // up to +12 dB
+            Smear        // magnitudes towards their neighbours' in time and frequency
+        };
+
+        Mode  mode = Mode::Erase;
+        float x = 0.0f;           // 0-1 across the sample
+        float y = 0.0f;           // 0-1 down the canvas, maxFreq at the top, log-spaced
+        float radiusX = 0.01f;    // same units; soft-edged ellipse
+        float radiusY = 0.02f;
+        float amount = 1.0f;      // 0-1 at the centre of the dab
+    };
+
+    SampleSpectrum();
+
+    // Takes the audio and drops every cached frame. The frequency range maps brush y to Hz.
+    void setSource(juce::AudioBuffer<float>&& audio, double sampleRate, float minFreq, float maxFreq);
+    void clear();
+
+    bool isEmpty() const { return numSamples == 0; }
+    int getNumChannels() const { return source.getNumChannels(); }
+    int getNumSamples() const { return numSamples; }
+
+    void applyBrush(const Brush& brush);
+
+    // The samples that sound different since the last call, then forgets them
+    juce::Range<int> takeDirtySamples();
+    // Puts samples back to be taken again, such as a splice that couldn't be sent
+    void markDirty(juce::Range<int> samples);
+
+    // Resynthesises numToRender samples from startSample into dest, which needs
+    // getNumChannels() channels; samples outside every edited frame are the original
+    void render(int startSample, juce::AudioBuffer<float>& dest, int numToRender);
+
+private:
+    int getNumFrames() const { return numSamples > 0 ? (numSamples - 1) / hopSize + 2 : 0; }
+    static int getFrameStart(int frame) { return (frame - 1) * hopSize; }   // frame f is centred on sample f * hopSize
+
+    void readFrame(int channel, int frame, float* dest) const;   // windowed, fftSize samples
+    void ensureFrame(int frame);
+    void decodeFrame(int frame, float* dest) const;              // every channel's bins, over fftSize as stored
+    void encodeFrame(int frame, float* bins);
+    void addDirtyFrames(int first, int last);
+
+    static constexpr float maxBoost = 4.0f;
+    static constexpr float maxStored = 256.0f;   // keeps boosted bins inside half range
+
+    juce::AudioBuffer<float> source;
+    int numSamples = 0;
+    double sampleRate = 44100.0;
+    float minFreq = 20.0f, maxFreq = 20000.0f;
+
+    juce::dsp::FFT fft{ fftOrder };
+    std::vector<float> window;                   // sqrt Hann; analysis and synthesis
+    std::vector<float> binY;                     // each bin's canvas y
+    std::vector<std::vector<juce::uint16>> frames;   // per frame, channels * numBins (re, im); empty until cached
+    std::vector<bool> edited;
+    juce::Range<int> dirtyFrames;
+
+    // Scratch
+    std::vector<float> fftData;                  // 2 * fftSize
+    std::vector<float> previous, current, next, result;   // decoded frames, channels * numBins * 2
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SampleSpectrum)
+};
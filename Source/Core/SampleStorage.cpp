@@ -0,0 +1,245 @@
+// Core/SampleStorage.cpp
+#include "SampleStorage.h"
+#include "SimdSupport.h"
+#include <cstring>
+
+namespace
+{
+    constexpr float int16Scale = 1.0f / 32768.0f;
+
+    inline juce::uint32 floatBits(float f) noexcept    { juce::uint32 u; std::memcpy(&u, &f, sizeof(u)); return u; }
+    inline float bitsToFloat(juce::uint32 u) noexcept  { float f; std::memcpy(&f, &u, sizeof(f)); return f; }
+
+    // Exact half -> float, including denormals and Inf/NaN
+    inline float halfToFloat(juce::uint16 h) noexcept
+    {
+        constexpr juce::uint32 shiftedExp = 0x7c00u << 13;
+        const float magic = bitsToFloat(113u << 23);
+
+        juce::uint32 u = (juce::uint32)(h & 0x7fffu) << 13;
+        const juce::uint32 exp = shiftedExp & u;
+        u += (127u - 15u) << 23;
+
+        if (exp == shiftedExp)      // Inf/NaN
+            u += (128u - 16u) << 23;
+        else if (exp == 0)          // zero/denormal
+            u = floatBits(bitsToFloat(u + (1u << 23)) - magic);
+
+        return bitsToFloat(u | ((juce::uint32)(h & 0x8000u) << 16));
+    }
+
+    // Round-to-nearest-even float -> half, saturating to Inf
+    inline juce::uint16 floatToHalf(float f) noexcept
+    {
+        constexpr juce::uint32 f32Infinity = 255u << 23;
+        constexpr juce::uint32 f16Max = (127u + 16u) << 23;
+        constexpr juce::uint32 denormMagicBits = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+        juce::uint32 u = floatBits(f);
+        const juce::uint32 sign = u & 0x80000000u;
+        u ^= sign;
+
+        juce::uint32 out;
+        if (u >= f16Max)
+        {
+            out = u > f32Infinity ? 0x7e00u : 0x7c00u;
+        }
+        else if (u < (113u << 23))
+        {
+            out = floatBits(bitsToFloat(u) + bitsToFloat(denormMagicBits)) - denormMagicBits;
+        }
+        else
+        {
+            const juce::uint32 mantissaOdd = (u >> 13) & 1u;
+            u += ((juce::uint32)(15 - 127) << 23) + 0xfffu;
+            u += mantissaOdd;
+            out = u >> 13;
+        }
+
+        return (juce::uint16)(out | (sign >> 16));
+    }
+}
+
+//==============================================================================
+void SampleStorage::setFrom(const juce::AudioBuffer<float>& source, Format newFormat)
+{
+    format = newFormat;
+    numChannels = source.getNumChannels();
+    numSamples = source.getNumSamples();
+
+    const size_t total = (size_t)numChannels * (size_t)numSamples;
+
+    if (format == Format::Float32)
+    {
+        packedData.clear();
+        packedData.shrink_to_fit();
+        floatData.resize(total);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            juce::FloatVectorOperations::copy(floatData.data() + (size_t)ch * (size_t)numSamples,
+                                              source.getReadPointer(ch), numSamples);
+    }
+    else
+    {
+        floatData.clear();
+        floatData.shrink_to_fit();
+        packedData.resize(total);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* dest = packedData.data() + (size_t)ch * (size_t)numSamples;
+
+            if (format == Format::Int16)
+                encodeInt16(source.getReadPointer(ch), reinterpret_cast<juce::int16*>(dest), numSamples);
+            else
+                encodeHalf(source.getReadPointer(ch), dest, numSamples);
+        }
+    }
+}
+
+void SampleStorage::clear()
+{
+    floatData.clear();
+    packedData.clear();
+    numChannels = 0;
+    numSamples = 0;
+}
+
+size_t SampleStorage::getMemoryBytes() const noexcept
+{
+    return floatData.size() * sizeof(float) + packedData.size() * sizeof(juce::uint16);
+}
+
+//==============================================================================
+void SampleStorage::readWindow(int channel, int startIndex, int numToRead, float* dest) const noexcept
+{
+    jassert(juce::isPositiveAndBelow(channel, numChannels));
+
+    if (numSamples == 0)
+    {
+        juce::FloatVectorOperations::clear(dest, numToRead);
+        return;
+    }
+
+    int index = startIndex % numSamples;
+    if (index < 0)
+        index += numSamples;
+
+    while (numToRead > 0)
+    {
+        const int run = juce::jmin(numToRead, numSamples - index);
+        decodeRange(channel, index, run, dest);
+
+        dest += run;
+        numToRead -= run;
+        index = 0;
+    }
+}
+
+void SampleStorage::writeRange(int channel, int startIndex, const float* src, int num) noexcept
+{
+    jassert(juce::isPositiveAndBelow(channel, numChannels));
+    jassert(startIndex >= 0 && num >= 0 && startIndex + num <= numSamples);
+
+    const size_t offset = (size_t)channel * (size_t)numSamples + (size_t)startIndex;
+
+    switch (format)
+    {
+    case Format::Float32:
+        std::memcpy(floatData.data() + offset, src, sizeof(float) * (size_t)num);
+        break;
+    case Format::Int16:
+        encodeInt16(src, reinterpret_cast<juce::int16*>(packedData.data() + offset), num);
+        break;
+    case Format::Half:
+        encodeHalf(src, packedData.data() + offset, num);
+        break;
+    }
+}
+
+void SampleStorage::decodeRange(int channel, int startIndex, int num, float* dest) const noexcept
+{
+    const size_t offset = (size_t)channel * (size_t)numSamples + (size_t)startIndex;
+
+    switch (format)
+    {
+    case Format::Float32:
+        std::memcpy(dest, floatData.data() + offset, sizeof(float) * (size_t)num);
+        break;
+    case Format::Int16:
+        decodeInt16(reinterpret_cast<const juce::int16*>(packedData.data() + offset), dest, num);
+        break;
+    case Format::Half:
+        decodeHalf(packedData.data() + offset, dest, num);
+        break;
+    }
+}
+
+//==============================================================================
+// Conversion kernels
+
+void SampleStorage::decodeInt16(const juce::int16* src, float* dest, int num) noexcept
+{
+    int i = 0;
+
+#if ARTEFACT_SIMD_SSE2
+    const __m128 scale = _mm_set1_ps(int16Scale);
+    for (; i + 8 <= num; i += 8)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        _mm_storeu_ps(dest + i,     _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(dest + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+#elif ARTEFACT_SIMD_NEON
+    for (; i + 8 <= num; i += 8)
+    {
+        const int16x8_t v = vld1q_s16(src + i);
+        vst1q_f32(dest + i,     vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))),  int16Scale));
+        vst1q_f32(dest + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), int16Scale));
+    }
+#endif
+
+    for (; i < num; ++i)
+        dest[i] = (float)src[i] * int16Scale;
+}
+
+void SampleStorage::decodeHalf(const juce::uint16* src, float* dest, int num) noexcept
+{
+    int i = 0;
+
+#if ARTEFACT_SIMD_F16C
+    for (; i + 8 <= num; i += 8)
+        _mm256_storeu_ps(dest + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+#elif ARTEFACT_SIMD_NEON && (defined(__aarch64__) || defined(_M_ARM64))
+    for (; i + 4 <= num; i += 4)
+        vst1q_f32(dest + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src + i))));
+#endif
+
+    for (; i < num; ++i)
+        dest[i] = halfToFloat(src[i]);
+}
+
+void SampleStorage::encodeInt16(const float* src, juce::int16* dest, int num) noexcept
+{
+    for (int i = 0; i < num; ++i)
+    {
+        const float scaled = juce::jlimit(-32768.0f, 32767.0f, std::round(src[i] * 32768.0f));
+        dest[i] = (juce::int16)scaled;
+    }
+}
+
+void SampleStorage::encodeHalf(const float* src, juce::uint16* dest, int num) noexcept
+{
+    int i = 0;
+
+#if ARTEFACT_SIMD_F16C
+    for (; i + 8 <= num; i += 8)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i),
+                         _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT));
+#endif
+
+    for (; i < num; ++i)
+        dest[i] = floatToHalf(src[i]);
+}
@@ -0,0 +1,54 @@
+// Core/SampleStorage.h
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+//==============================================================================
+// Channel-planar sample memory for ForgeVoice.
+// Samples can be held as 32-bit float, 16-bit integer or IEEE half precision;
+// every read decodes to float, so the render kernel never sees the format.
+class SampleStorage
+{
+public:
+    enum class Format { Float32 = 0, Int16, Half };
+
+    SampleStorage() = default;
+
+    void setFrom(const juce::AudioBuffer<float>& source, Format newFormat);
+    void clear();
+
+    Format getFormat() const noexcept { return format; }
+    int getNumChannels() const noexcept { return numChannels; }
+    int getNumSamples() const noexcept { return numSamples; }
+    bool isEmpty() const noexcept { return numSamples == 0; }
+
+    // Decodes numToRead samples of one channel into dest, starting at startIndex.
+    // Indices past the end wrap back to the start so loop windows stay contiguous.
+    void readWindow(int channel, int startIndex, int numToRead, float* dest) const noexcept;
+
+    // Overwrites num samples of one channel in place, encoding to the storage format.
+    // The range must lie inside the sample; no allocation, so the audio thread may call it.
+    void writeRange(int channel, int startIndex, const float* src, int num) noexcept;
+
+    // Memory accounting (sample data only)
+    size_t getMemoryBytes() const noexcept;
+    size_t getFloat32MemoryBytes() const noexcept { return sizeof(float) * (size_t)numChannels * (size_t)numSamples; }
+    size_t getMemorySavedBytes() const noexcept { return getFloat32MemoryBytes() - getMemoryBytes(); }
+
+    // Format conversion kernels, exposed for other sample consumers
+    static void decodeInt16(const juce::int16* src, float* dest, int num) noexcept;
+    static void decodeHalf(const juce::uint16* src, float* dest, int num) noexcept;
+    static void encodeInt16(const float* src, juce::int16* dest, int num) noexcept;
+    static void encodeHalf(const float* src, juce::uint16* dest, int num) noexcept;
+
+private:
+    void decodeRange(int channel, int startIndex, int num, float* dest) const noexcept;
+
+    Format format = Format::Float32;
+    int numChannels = 0;
+    int numSamples = 0;
+
+    std::vector<float>        floatData;   // Float32
+    std::vector<juce::uint16> packedData;  // Int16 (two's complement) or Half bits
+};
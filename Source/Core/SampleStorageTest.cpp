@@ -0,0 +1,226 @@
+#include "SampleStorage.h"
+#include <JuceHeader.h>
+#include <cmath>
+#include <cstring>
+
+/**
+ * Round-trip tests for SampleStorage's int16 and half formats.
+ * Run after touching the conversion kernels; both the SIMD body and the
+ * scalar tail are covered, since every length below leaves a remainder.
+ */
+class SampleStorageTest
+{
+public:
+    static bool runBasicTests()
+    {
+        DBG("=== SampleStorage Round-Trip Tests ===");
+
+        // Test 1: Every 16-bit value survives int16 storage exactly
+        if (!testInt16RoundTrip())
+            return false;
+
+        // Test 2: Every finite half survives decode and re-encode bit for bit
+        if (!testHalfBitsRoundTrip())
+            return false;
+
+        // Test 3: Arbitrary floats stay within half precision
+        if (!testHalfPrecision())
+            return false;
+
+        // Test 4: writeRange encodes in place and leaves its neighbours alone
+        if (!testWriteRange())
+            return false;
+
+        // Test 5: Memory accounting
+        if (!testMemoryAccounting())
+            return false;
+
+        DBG("=== All SampleStorage tests passed! ===");
+        return true;
+    }
+
+private:
+    static constexpr int numInt16Values = 65536;
+
+    static bool testInt16RoundTrip()
+    {
+        DBG("Testing int16 round trip...");
+
+        // One more than the value count, so the last SIMD block is partial
+        const int numSamples = numInt16Values + 3;
+        juce::AudioBuffer<float> source(2, numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const int value = i % numInt16Values;
+            source.setSample(0, i, (float)(value - 32768) / 32768.0f);
+            source.setSample(1, i, (float)(32767 - value) / 32768.0f);
+        }
+
+        SampleStorage storage;
+        storage.setFrom(source, SampleStorage::Format::Int16);
+
+        std::vector<float> decoded((size_t)numSamples);
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            storage.readWindow(ch, 0, numSamples, decoded.data());
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                if (decoded[(size_t)i] != source.getSample(ch, i))
+                {
+                    DBG("FAIL: int16 channel " << ch << " sample " << i << " decoded as "
+                        << decoded[(size_t)i] << ", expected " << source.getSample(ch, i));
+                    return false;
+                }
+            }
+        }
+
+        DBG("✓ Int16 round-trip test passed");
+        return true;
+    }
+
+    static bool testHalfBitsRoundTrip()
+    {
+        DBG("Testing half bit round trip...");
+
+        std::vector<juce::uint16> bits;
+        for (int i = 0; i < numInt16Values; ++i)
+        {
+            // Skip Inf and NaN; their payloads need not survive
+            if ((i & 0x7c00) != 0x7c00)
+                bits.push_back((juce::uint16)i);
+        }
+
+        const int num = (int)bits.size();
+        std::vector<float> decoded((size_t)num);
+        std::vector<juce::uint16> encoded((size_t)num);
+
+        SampleStorage::decodeHalf(bits.data(), decoded.data(), num);
+        SampleStorage::encodeHalf(decoded.data(), encoded.data(), num);
+
+        for (int i = 0; i < num; ++i)
+        {
+            if (encoded[(size_t)i] != bits[(size_t)i])
+            {
+                DBG("FAIL: half 0x" << juce::String::toHexString((int)bits[(size_t)i]) << " came back as 0x"
+                    << juce::String::toHexString((int)encoded[(size_t)i]));
+                return false;
+            }
+        }
+
+        DBG("✓ Half bit round-trip test passed");
+        return true;
+    }
+
+    static bool testHalfPrecision()
+    {
+        DBG("Testing half precision...");
+
+        const int numSamples = 4099;
+        juce::AudioBuffer<float> source(1, numSamples);
+        juce::Random random(0x5eed);
+
+        for (int i = 0; i < numSamples; ++i)
+            source.setSample(0, i, (random.nextFloat() * 2.0f - 1.0f) * std::pow(2.0f, -(float)(i % 12)));
+
+        SampleStorage storage;
+        storage.setFrom(source, SampleStorage::Format::Half);
+
+        std::vector<float> decoded((size_t)numSamples);
+        storage.readWindow(0, 0, numSamples, decoded.data());
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            // Round to nearest: half an ulp of an 11-bit significand, plus the denormal step
+            const float expected = source.getSample(0, i);
+            const float tolerance = std::abs(expected) * std::pow(2.0f, -11.0f) + std::pow(2.0f, -25.0f);
+
+            if (std::abs(decoded[(size_t)i] - expected) > tolerance)
+            {
+                DBG("FAIL: half sample " << i << " decoded as " << decoded[(size_t)i] << ", expected " << expected);
+                return false;
+            }
+        }
+
+        DBG("✓ Half precision test passed");
+        return true;
+    }
+
+    static bool testWriteRange()
+    {
+        DBG("Testing writeRange...");
+
+        for (auto format : { SampleStorage::Format::Float32, SampleStorage::Format::Int16, SampleStorage::Format::Half })
+        {
+            const int numSamples = 100;
+            juce::AudioBuffer<float> source(1, numSamples);
+            for (int i = 0; i < numSamples; ++i)
+                source.setSample(0, i, (float)i / 128.0f);
+
+            SampleStorage storage;
+            storage.setFrom(source, format);
+
+            // Every value here is a multiple of 1/128, exact in all three formats
+            std::vector<float> patch(13);
+            for (size_t i = 0; i < patch.size(); ++i)
+                patch[i] = -(float)i / 128.0f;
+
+            storage.writeRange(0, 41, patch.data(), (int)patch.size());
+
+            std::vector<float> decoded((size_t)numSamples);
+            storage.readWindow(0, 0, numSamples, decoded.data());
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const bool patched = i >= 41 && i < 41 + (int)patch.size();
+                const float expected = patched ? patch[(size_t)(i - 41)] : source.getSample(0, i);
+
+                if (decoded[(size_t)i] != expected)
+                {
+                    DBG("FAIL: format " << (int)format << " sample " << i << " is " << decoded[(size_t)i]
+                        << " after writeRange, expected " << expected);
+                    return false;
+                }
+            }
+        }
+
+        DBG("✓ writeRange test passed");
+        return true;
+    }
+
+    static bool testMemoryAccounting()
+    {
+        DBG("Testing memory accounting...");
+
+        juce::AudioBuffer<float> source(2, 1000);
+        source.clear();
+
+        SampleStorage storage;
+        storage.setFrom(source, SampleStorage::Format::Float32);
+        if (storage.getMemoryBytes() != 8000 || storage.getMemorySavedBytes() != 0)
+        {
+            DBG("FAIL: float32 storage should use 8000 bytes and save none");
+            return false;
+        }
+
+        for (auto format : { SampleStorage::Format::Int16, SampleStorage::Format::Half })
+        {
+            storage.setFrom(source, format);
+            if (storage.getMemoryBytes() != 4000 || storage.getMemorySavedBytes() != 4000)
+            {
+                DBG("FAIL: format " << (int)format << " should use and save 4000 bytes");
+                return false;
+            }
+        }
+
+        DBG("✓ Memory accounting test passed");
+        return true;
+    }
+};
+
+// Function to run tests (can be called from main application for validation)
+bool testSampleStorage()
+{
+    return SampleStorageTest::runBasicTests();
+}
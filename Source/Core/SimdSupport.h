@@ -0,0 +1,37 @@
+// Core/SimdSupport.h
+#pragma once
+
+// ──────────────────────────────────────────────────────────────────────────────
+// Compile-time SIMD feature detection for the hand-written DSP kernels.
+// Every kernel keeps a scalar fallback, so any of these may be 0.
+// AVX2 and F16C are only set when the build enables them: configure with
+// -DARTEFACT_ENABLE_AVX2=ON (see CMakeLists.txt).
+// ──────────────────────────────────────────────────────────────────────────────
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #define ARTEFACT_SIMD_SSE2 1
+ #include <emmintrin.h>
+#else
+ #define ARTEFACT_SIMD_SSE2 0
+#endif
+
+#if defined(__AVX2__)
+ #define ARTEFACT_SIMD_AVX2 1
+ #include <immintrin.h>
+#else
+ #define ARTEFACT_SIMD_AVX2 0
+#endif
+
+// MSVC has no separate F16C switch; every AVX2-capable CPU has it.
+#if defined(__F16C__) || (defined(_MSC_VER) && ARTEFACT_SIMD_AVX2)
+ #define ARTEFACT_SIMD_F16C 1
+ #include <immintrin.h>
+#else
+ #define ARTEFACT_SIMD_F16C 0
+#endif
+
+#if defined(__ARM_NEON) || defined(_M_ARM64)
+ #define ARTEFACT_SIMD_NEON 1
+ #include <arm_neon.h>
+#else
+ #define ARTEFACT_SIMD_NEON 0
+#endif
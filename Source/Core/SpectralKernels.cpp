@@ -0,0 +1,257 @@
+// Core/SpectralKernels.cpp
+#include "SpectralKernels.h"
+#include "SimdSupport.h"
+#include <cmath>
+
+namespace SpectralKernels
+{
+
+namespace
+{
+    //==========================================================================
+    // Polynomial atan2 and sincos, branch-free so each has the same shape in
+    // every SIMD width. The scalar versions handle the tails and are the reference.
+
+    constexpr float pi = juce::MathConstants<float>::pi;
+    constexpr float halfPi = juce::MathConstants<float>::halfPi;
+    constexpr float twoOverPi = 1.0f / halfPi;
+
+    // atan(a) on [0, 1], odd minimax polynomial
+    constexpr float atan1 = 0.99997726f, atan3 = -0.33262347f, atan5 = 0.19354346f,
+                    atan7 = -0.11643287f, atan9 = 0.05265332f, atan11 = -0.01172120f;
+
+    // sin and cos on [-pi/4, pi/4] (Cephes sinf/cosf)
+    constexpr float sin3 = -1.6666654611e-1f, sin5 = 8.3321608736e-3f, sin7 = -1.9515295891e-4f;
+    constexpr float cos4 = 4.166664568298827e-2f, cos6 = -1.388731625493765e-3f, cos8 = 2.443315711809948e-5f;
+
+    // pi/2 split in three so the range reduction stays exact for a few turns
+    constexpr float halfPi1 = 1.5703125f, halfPi2 = 4.837512969970703125e-4f, halfPi3 = 7.54978995489188216e-8f;
+
+    // Keeps 0/0 finite; the bin's phase is then 0
+    constexpr float tiny = 1.0e-30f;
+
+    inline float atan2Scalar(float y, float x) noexcept
+    {
+        const float ax = std::abs(x), ay = std::abs(y);
+        const float a = juce::jmin(ax, ay) / (juce::jmax(ax, ay) + tiny);
+        const float s = a * a;
+
+        float r = a * (atan1 + s * (atan3 + s * (atan5 + s * (atan7 + s * (atan9 + s * atan11)))));
+        r = ay > ax ? halfPi - r : r;
+        r = x < 0.0f ? pi - r : r;
+        return std::copysign(r, y);
+    }
+
+    inline void sinCosScalar(float x, float& s, float& c) noexcept
+    {
+        const float j = ForgeKernels::fastRound(x * twoOverPi);
+        const float r = ((x - j * halfPi1) - j * halfPi2) - j * halfPi3;
+        const float r2 = r * r;
+
+        const float sinR = r + r * r2 * (sin3 + r2 * (sin5 + r2 * sin7));
+        const float cosR = 1.0f - 0.5f * r2 + r2 * r2 * (cos4 + r2 * (cos6 + r2 * cos8));
+
+        // Quadrant: odd ones swap sin and cos, and each function has its own sign pattern
+        const int q = (int)j;
+        const bool swap = (q & 1) != 0;
+        s = (q & 2) != 0 ? -(swap ? cosR : sinR) : (swap ? cosR : sinR);
+        c = ((q + 1) & 2) != 0 ? -(swap ? sinR : cosR) : (swap ? sinR : cosR);
+    }
+
+#if ARTEFACT_SIMD_AVX2
+    inline __m256 atan2Avx(__m256 y, __m256 x) noexcept
+    {
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+        const __m256 ax = _mm256_andnot_ps(signMask, x);
+        const __m256 ay = _mm256_andnot_ps(signMask, y);
+        const __m256 a = _mm256_div_ps(_mm256_min_ps(ax, ay), _mm256_add_ps(_mm256_max_ps(ax, ay), _mm256_set1_ps(tiny)));
+        const __m256 s = _mm256_mul_ps(a, a);
+
+        __m256 p = _mm256_set1_ps(atan11);
+        p = _mm256_add_ps(_mm256_mul_ps(p, s), _mm256_set1_ps(atan9));
+        p = _mm256_add_ps(_mm256_mul_ps(p, s), _mm256_set1_ps(atan7));
+        p = _mm256_add_ps(_mm256_mul_ps(p, s), _mm256_set1_ps(atan5));
+        p = _mm256_add_ps(_mm256_mul_ps(p, s), _mm256_set1_ps(atan3));
+        p = _mm256_add_ps(_mm256_mul_ps(p, s), _mm256_set1_ps(atan1));
+        __m256 r = _mm256_mul_ps(p, a);
+
+        r = _mm256_blendv_ps(r, _mm256_sub_ps(_mm256_set1_ps(halfPi), r), _mm256_cmp_ps(ay, ax, _CMP_GT_OQ));
+        r = _mm256_blendv_ps(r, _mm256_sub_ps(_mm256_set1_ps(pi), r), x);   // blendv reads the sign bit
+        return _mm256_or_ps(r, _mm256_and_ps(signMask, y));
+    }
+
+    inline void sinCosAvx(__m256 x, __m256& s, __m256& c) noexcept
+    {
+        const __m256i q = _mm256_cvtps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(twoOverPi)));
+        const __m256 j = _mm256_cvtepi32_ps(q);
+
+        __m256 r = _mm256_sub_ps(x, _mm256_mul_ps(j, _mm256_set1_ps(halfPi1)));
+        r = _mm256_sub_ps(r, _mm256_mul_ps(j, _mm256_set1_ps(halfPi2)));
+        r = _mm256_sub_ps(r, _mm256_mul_ps(j, _mm256_set1_ps(halfPi3)));
+        const __m256 r2 = _mm256_mul_ps(r, r);
+
+        __m256 sinR = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(sin7), r2), _mm256_set1_ps(sin5));
+        sinR = _mm256_add_ps(_mm256_mul_ps(sinR, r2), _mm256_set1_ps(sin3));
+        sinR = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(sinR, r2), r), r);
+
+        __m256 cosR = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(cos8), r2), _mm256_set1_ps(cos6));
+        cosR = _mm256_add_ps(_mm256_mul_ps(cosR, r2), _mm256_set1_ps(cos4));
+        cosR = _mm256_mul_ps(_mm256_mul_ps(cosR, r2), r2);
+        cosR = _mm256_add_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(_mm256_set1_ps(0.5f), r2)), cosR);
+
+        const __m256i one = _mm256_set1_epi32(1), two = _mm256_set1_epi32(2);
+        const __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(q, one), one));
+        const __m256 sinSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(q, two), 30));
+        const __m256 cosSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(q, one), two), 30));
+
+        s = _mm256_xor_ps(_mm256_blendv_ps(sinR, cosR, swap), sinSign);
+        c = _mm256_xor_ps(_mm256_blendv_ps(cosR, sinR, swap), cosSign);
+    }
+#endif
+
+#if ARTEFACT_SIMD_SSE2
+    inline __m128 select(__m128 mask, __m128 ifTrue, __m128 ifFalse) noexcept
+    {
+        return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse));
+    }
+
+    inline __m128 atan2Sse(__m128 y, __m128 x) noexcept
+    {
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        const __m128 ax = _mm_andnot_ps(signMask, x);
+        const __m128 ay = _mm_andnot_ps(signMask, y);
+        const __m128 a = _mm_div_ps(_mm_min_ps(ax, ay), _mm_add_ps(_mm_max_ps(ax, ay), _mm_set1_ps(tiny)));
+        const __m128 s = _mm_mul_ps(a, a);
+
+        __m128 p = _mm_set1_ps(atan11);
+        p = _mm_add_ps(_mm_mul_ps(p, s), _mm_set1_ps(atan9));
+        p = _mm_add_ps(_mm_mul_ps(p, s), _mm_set1_ps(atan7));
+        p = _mm_add_ps(_mm_mul_ps(p, s), _mm_set1_ps(atan5));
+        p = _mm_add_ps(_mm_mul_ps(p, s), _mm_set1_ps(atan3));
+        p = _mm_add_ps(_mm_mul_ps(p, s), _mm_set1_ps(atan1));
+        __m128 r = _mm_mul_ps(p, a);
+
+        r = select(_mm_cmpgt_ps(ay, ax), _mm_sub_ps(_mm_set1_ps(halfPi), r), r);
+        r = select(_mm_cmplt_ps(x, _mm_setzero_ps()), _mm_sub_ps(_mm_set1_ps(pi), r), r);
+        return _mm_or_ps(r, _mm_and_ps(signMask, y));
+    }
+
+    inline void sinCosSse(__m128 x, __m128& s, __m128& c) noexcept
+    {
+        const __m128i q = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(twoOverPi)));
+        const __m128 j = _mm_cvtepi32_ps(q);
+
+        __m128 r = _mm_sub_ps(x, _mm_mul_ps(j, _mm_set1_ps(halfPi1)));
+        r = _mm_sub_ps(r, _mm_mul_ps(j, _mm_set1_ps(halfPi2)));
+        r = _mm_sub_ps(r, _mm_mul_ps(j, _mm_set1_ps(halfPi3)));
+        const __m128 r2 = _mm_mul_ps(r, r);
+
+        __m128 sinR = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(sin7), r2), _mm_set1_ps(sin5));
+        sinR = _mm_add_ps(_mm_mul_ps(sinR, r2), _mm_set1_ps(sin3));
+        sinR = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sinR, r2), r), r);
+
+        __m128 cosR = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(cos8), r2), _mm_set1_ps(cos6));
+        cosR = _mm_add_ps(_mm_mul_ps(cosR, r2), _mm_set1_ps(cos4));
+        cosR = _mm_mul_ps(_mm_mul_ps(cosR, r2), r2);
+        cosR = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_set1_ps(0.5f), r2)), cosR);
+
+        const __m128i one = _mm_set1_epi32(1), two = _mm_set1_epi32(2);
+        const __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(q, one), one));
+        const __m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(q, two), 30));
+        const __m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(q, one), two), 30));
+
+        s = _mm_xor_ps(select(swap, cosR, sinR), sinSign);
+        c = _mm_xor_ps(select(swap, sinR, cosR), cosSign);
+    }
+#endif
+}
+
+//==============================================================================
+void toPolar(const float* bins, float* magnitude, float* phase, int numBins) noexcept
+{
+    int i = 0;
+
+#if ARTEFACT_SIMD_AVX2
+    for (; i + 8 <= numBins; i += 8)
+    {
+        // (re, im) pairs -> eight re and eight im; the shuffle works per 128-bit lane, the permute undoes that
+        const __m256 a = _mm256_loadu_ps(bins + 2 * i);
+        const __m256 b = _mm256_loadu_ps(bins + 2 * i + 8);
+        const __m256 re = _mm256_castpd_ps(_mm256_permute4x64_pd(
+            _mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))), _MM_SHUFFLE(3, 1, 2, 0)));
+        const __m256 im = _mm256_castpd_ps(_mm256_permute4x64_pd(
+            _mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1))), _MM_SHUFFLE(3, 1, 2, 0)));
+
+        _mm256_storeu_ps(magnitude + i, _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(re, re), _mm256_mul_ps(im, im))));
+        _mm256_storeu_ps(phase + i, atan2Avx(im, re));
+    }
+#endif
+
+#if ARTEFACT_SIMD_SSE2
+    for (; i + 4 <= numBins; i += 4)
+    {
+        const __m128 a = _mm_loadu_ps(bins + 2 * i);
+        const __m128 b = _mm_loadu_ps(bins + 2 * i + 4);
+        const __m128 re = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 im = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+
+        _mm_storeu_ps(magnitude + i, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(re, re), _mm_mul_ps(im, im))));
+        _mm_storeu_ps(phase + i, atan2Sse(im, re));
+    }
+#endif
+
+    for (; i < numBins; ++i)
+    {
+        const float re = bins[2 * i], im = bins[2 * i + 1];
+        magnitude[i] = std::sqrt(re * re + im * im);
+        phase[i] = atan2Scalar(im, re);
+    }
+}
+
+void fromPolar(const float* magnitude, const float* phase, float* bins, int numBins) noexcept
+{
+    int i = 0;
+
+#if ARTEFACT_SIMD_AVX2
+    for (; i + 8 <= numBins; i += 8)
+    {
+        __m256 s, c;
+        sinCosAvx(_mm256_loadu_ps(phase + i), s, c);
+
+        const __m256 m = _mm256_loadu_ps(magnitude + i);
+        const __m256 re = _mm256_mul_ps(m, c);
+        const __m256 im = _mm256_mul_ps(m, s);
+
+        // Interleave per lane, then put the lanes back in order
+        const __m256 low = _mm256_unpacklo_ps(re, im);
+        const __m256 high = _mm256_unpackhi_ps(re, im);
+        _mm256_storeu_ps(bins + 2 * i, _mm256_permute2f128_ps(low, high, 0x20));
+        _mm256_storeu_ps(bins + 2 * i + 8, _mm256_permute2f128_ps(low, high, 0x31));
+    }
+#endif
+
+#if ARTEFACT_SIMD_SSE2
+    for (; i + 4 <= numBins; i += 4)
+    {
+        __m128 s, c;
+        sinCosSse(_mm_loadu_ps(phase + i), s, c);
+
+        const __m128 m = _mm_loadu_ps(magnitude + i);
+        const __m128 re = _mm_mul_ps(m, c);
+        const __m128 im = _mm_mul_ps(m, s);
+
+        _mm_storeu_ps(bins + 2 * i, _mm_unpacklo_ps(re, im));
+        _mm_storeu_ps(bins + 2 * i + 4, _mm_unpackhi_ps(re, im));
+    }
+#endif
+
+    for (; i < numBins; ++i)
+    {
+        float s, c;
+        sinCosScalar(phase[i], s, c);
+        bins[2 * i] = magnitude[i] * c;
+        bins[2 * i + 1] = magnitude[i] * s;
+    }
+}
+
+} // namespace SpectralKernels
@@ -0,0 +1,25 @@
+// Core/SpectralKernels.h
+#pragma once
+
+#include <JuceHeader.h>
+#include "ForgeKernels.h"
+
+//==============================================================================
+// Block kernels for the STFT engines. Spectra are laid out the way
+// juce::dsp::FFT's real-only transforms leave them: numBins interleaved
+// (re, im) pairs, numBins = fftSize / 2 + 1.
+namespace SpectralKernels
+{
+    // Magnitude and phase in [-pi, pi] of each bin. Phase is accurate to ~1e-5 rad.
+    void toPolar(const float* bins, float* magnitude, float* phase, int numBins) noexcept;
+
+    // Back to (re, im). Phases should be within a few turns of zero; wrap accumulated ones first.
+    void fromPolar(const float* magnitude, const float* phase, float* bins, int numBins) noexcept;
+
+    // Wraps a phase into [-pi, pi], valid for |x| < 2^21
+    inline float wrapPhase(float x) noexcept
+    {
+        constexpr float twoPi = juce::MathConstants<float>::twoPi;
+        return x - twoPi * ForgeKernels::fastRound(x * (1.0f / twoPi));
+    }
+}
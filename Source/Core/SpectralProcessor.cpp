@@ -0,0 +1,277 @@
+// Core/SpectralProcessor.cpp
+#include "SpectralProcessor.h"
+#include "SpectralKernels.h"
+#include <cmath>
+#include <cstring>
+
+void SpectralProcessor::prepare(double newSampleRate, int newMaxBlockSize, int numChannels)
+{
+    prepare(newSampleRate, newMaxBlockSize, numChannels, Settings());
+}
+
+void SpectralProcessor::prepare(double newSampleRate, int newMaxBlockSize, int numChannels, const Settings& newSettings)
+{
+    settings = newSettings;
+    settings.fftOrder = juce::jlimit(6, 15, settings.fftOrder);
+    settings.overlap = juce::jlimit(2, 16, settings.overlap);
+
+    sampleRate = newSampleRate;
+    fftSize = 1 << settings.fftOrder;
+    hopSize = juce::jmax(1, fftSize / settings.overlap);
+    numBins = fftSize / 2 + 1;
+    maxBlockSize = juce::jmax(1, newMaxBlockSize);
+
+    fft = std::make_unique<juce::dsp::FFT>(settings.fftOrder);
+    fftData.assign((size_t)fftSize * 2, 0.0f);
+
+    // Periodic windows, used for analysis and again for synthesis
+    window.resize((size_t)fftSize);
+    for (int i = 0; i < fftSize; ++i)
+    {
+        const float x = juce::MathConstants<float>::twoPi * (float)i / (float)fftSize;
+
+        switch (settings.window)
+        {
+        case Window::Hann:           window[(size_t)i] = 0.5f - 0.5f * std::cos(x); break;
+        case Window::Hamming:        window[(size_t)i] = 0.54f - 0.46f * std::cos(x); break;
+        case Window::BlackmanHarris: window[(size_t)i] = 0.35875f - 0.48829f * std::cos(x)
+                                                         + 0.14128f * std::cos(2.0f * x) - 0.01168f * std::cos(3.0f * x); break;
+        }
+    }
+
+    // Every output sample is the sum of the squared windows of the frames over it; dividing that
+    // out reconstructs exactly whatever the window and hop
+    outputGain.resize((size_t)hopSize);
+    for (int i = 0; i < hopSize; ++i)
+    {
+        float sum = 0.0f;
+        for (int j = i; j < fftSize; j += hopSize)
+            sum += window[(size_t)j] * window[(size_t)j];
+
+        outputGain[(size_t)i] = 1.0f / juce::jmax(sum, 1.0e-3f);
+    }
+
+    shiftedMagnitude.assign((size_t)numBins, 0.0f);
+    shiftedBin.assign((size_t)numBins, 0.0f);
+    morphTarget.assign((size_t)numBins, 0.0f);
+
+    channels.resize((size_t)juce::jmax(1, numChannels));
+    for (auto& channel : channels)
+    {
+        channel.input.assign((size_t)fftSize, 0.0f);
+        channel.overlapAdd.assign((size_t)fftSize, 0.0f);
+        channel.output.assign((size_t)(maxBlockSize + hopSize), 0.0f);
+        channel.analysis.magnitude.assign((size_t)numBins, 0.0f);
+        channel.analysis.phase.assign((size_t)numBins, 0.0f);
+        channel.previousPhase.assign((size_t)numBins, 0.0f);
+        channel.synthesisPhase.assign((size_t)numBins, 0.0f);
+    }
+
+    reset();
+}
+
+void SpectralProcessor::reset()
+{
+    for (auto& channel : channels)
+    {
+        std::fill(channel.input.begin(), channel.input.end(), 0.0f);
+        std::fill(channel.overlapAdd.begin(), channel.overlapAdd.end(), 0.0f);
+        std::fill(channel.output.begin(), channel.output.end(), 0.0f);
+        std::fill(channel.previousPhase.begin(), channel.previousPhase.end(), 0.0f);
+        channel.synthesisPhaseValid = false;
+    }
+
+    // A frame only completes every hop, so a hop less one sample of silence is waiting from the
+    // start; that way any block gets its output straight away
+    hopFill = 0;
+    numOutput = hopSize - 1;
+}
+
+//==============================================================================
+void SpectralProcessor::spectralShift(float semitones)
+{
+    shiftRatio = semitones == 0.0f ? 1.0f : std::pow(2.0f, semitones / 12.0f);
+}
+
+void SpectralProcessor::spectralStretch(float factor)
+{
+    stretchExponent = juce::jlimit(0.25f, 4.0f, factor);
+}
+
+void SpectralProcessor::morphSpectra(const Frame& target, float amount)
+{
+    jassert(target.getNumBins() == numBins);
+
+    morphAmount = target.getNumBins() == numBins ? juce::jlimit(0.0f, 1.0f, amount) : 0.0f;
+    if (morphAmount > 0.0f)
+        std::copy(target.magnitude.begin(), target.magnitude.end(), morphTarget.begin());
+}
+
+//==============================================================================
+void SpectralProcessor::process(juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    for (int done = 0; done < numSamples;)
+    {
+        const int num = juce::jmin(maxBlockSize, numSamples - done);
+        analyzeBuffer(buffer, startSample + done, num);
+        resynthesizeToBuffer(buffer, startSample + done, num);
+        done += num;
+    }
+}
+
+void SpectralProcessor::analyzeBuffer(const juce::AudioBuffer<float>& input, int startSample, int numSamples)
+{
+    jassert(numSamples <= maxBlockSize);
+
+    const int numInputChannels = input.getNumChannels();
+
+    for (int done = 0; done < numSamples;)
+    {
+        const int num = juce::jmin(numSamples - done, hopSize - hopFill);
+
+        for (size_t c = 0; c < channels.size(); ++c)
+        {
+            float* dest = channels[c].input.data() + (fftSize - hopSize + hopFill);
+
+            if ((int)c < numInputChannels)
+                juce::FloatVectorOperations::copy(dest, input.getReadPointer((int)c, startSample + done), num);
+            else
+                juce::FloatVectorOperations::clear(dest, num);
+        }
+
+        hopFill += num;
+        done += num;
+
+        if (hopFill == hopSize)
+        {
+            for (auto& channel : channels)
+            {
+                processFrame(channel);
+                std::memmove(channel.input.data(), channel.input.data() + hopSize, sizeof(float) * (size_t)(fftSize - hopSize));
+            }
+
+            hopFill = 0;
+            numOutput += hopSize;
+        }
+    }
+}
+
+void SpectralProcessor::resynthesizeToBuffer(juce::AudioBuffer<float>& output, int startSample, int numSamples)
+{
+    jassert(numSamples <= numOutput);
+    numSamples = juce::jmin(numSamples, numOutput);
+
+    const int remaining = numOutput - numSamples;
+
+    for (size_t c = 0; c < channels.size(); ++c)
+    {
+        float* pending = channels[c].output.data();
+
+        if ((int)c < output.getNumChannels())
+            juce::FloatVectorOperations::copy(output.getWritePointer((int)c, startSample), pending, numSamples);
+
+        std::memmove(pending, pending + numSamples, sizeof(float) * (size_t)remaining);
+    }
+
+    numOutput = remaining;
+}
+
+//==============================================================================
+void SpectralProcessor::processFrame(Channel& channel)
+{
+    float* data = fftData.data();
+
+    juce::FloatVectorOperations::multiply(data, channel.input.data(), window.data(), fftSize);
+    juce::FloatVectorOperations::clear(data + fftSize, fftSize);
+    fft->performRealOnlyForwardTransform(data, true);
+
+    auto& analysis = channel.analysis;
+    SpectralKernels::toPolar(data, analysis.magnitude.data(), analysis.phase.data(), numBins);
+
+    if (shiftRatio != 1.0f || stretchExponent != 1.0f)
+    {
+        shiftFrame(channel);
+    }
+    else
+    {
+        channel.synthesisPhaseValid = false;
+
+        // Morphing alone keeps the analysed phases; untransformed frames skip the round trip
+        if (morphAmount > 0.0f)
+        {
+            juce::FloatVectorOperations::multiply(shiftedMagnitude.data(), analysis.magnitude.data(), 1.0f - morphAmount, numBins);
+            juce::FloatVectorOperations::addWithMultiply(shiftedMagnitude.data(), morphTarget.data(), morphAmount, numBins);
+            SpectralKernels::fromPolar(shiftedMagnitude.data(), analysis.phase.data(), data, numBins);
+        }
+    }
+
+    juce::FloatVectorOperations::copy(channel.previousPhase.data(), analysis.phase.data(), numBins);
+
+    fft->performRealOnlyInverseTransform(data);
+    juce::FloatVectorOperations::addWithMultiply(channel.overlapAdd.data(), data, window.data(), fftSize);
+
+    // The oldest hop has had every frame over it
+    juce::FloatVectorOperations::multiply(channel.output.data() + numOutput, channel.overlapAdd.data(), outputGain.data(), hopSize);
+    std::memmove(channel.overlapAdd.data(), channel.overlapAdd.data() + hopSize, sizeof(float) * (size_t)(fftSize - hopSize));
+    juce::FloatVectorOperations::clear(channel.overlapAdd.data() + (fftSize - hopSize), hopSize);
+}
+
+void SpectralProcessor::shiftFrame(Channel& channel)
+{
+    const auto& magnitude = channel.analysis.magnitude;
+    const auto& phase = channel.analysis.phase;
+
+    // A sinusoid exactly on bin k advances its phase by k * expectedAdvance per hop;
+    // the remainder says how far off the bin centre it really is
+    const float expectedAdvance = juce::MathConstants<float>::twoPi * (float)hopSize / (float)fftSize;
+    const float binsPerRadian = 1.0f / expectedAdvance;
+    const float referenceBin = stretchReferenceHz * (float)fftSize / (float)sampleRate;
+    const bool stretching = stretchExponent != 1.0f;
+
+    juce::FloatVectorOperations::clear(shiftedMagnitude.data(), numBins);
+    juce::FloatVectorOperations::clear(shiftedBin.data(), numBins);
+
+    for (int k = 0; k < numBins; ++k)
+    {
+        const float deviation = SpectralKernels::wrapPhase(phase[(size_t)k] - channel.previousPhase[(size_t)k]
+                                                           - (float)k * expectedAdvance);
+        float bin = juce::jmax(0.0f, (float)k + deviation * binsPerRadian);
+
+        if (stretching)
+            bin = referenceBin * std::pow(bin / referenceBin, stretchExponent);
+
+        bin *= shiftRatio;
+
+        const int target = (int)(bin + 0.5f);
+        if (target >= numBins)
+            continue;
+
+        // Several bins can land on one; it keeps the loudest one's frequency
+        if (magnitude[(size_t)k] > shiftedMagnitude[(size_t)target])
+            shiftedBin[(size_t)target] = bin;
+
+        shiftedMagnitude[(size_t)target] += magnitude[(size_t)k];
+    }
+
+    if (morphAmount > 0.0f)
+    {
+        juce::FloatVectorOperations::multiply(shiftedMagnitude.data(), 1.0f - morphAmount, numBins);
+        juce::FloatVectorOperations::addWithMultiply(shiftedMagnitude.data(), morphTarget.data(), morphAmount, numBins);
+    }
+
+    // Start from the analysed phases so switching on doesn't click more than it must
+    auto& synthesisPhase = channel.synthesisPhase;
+    if (!channel.synthesisPhaseValid)
+    {
+        juce::FloatVectorOperations::copy(synthesisPhase.data(), phase.data(), numBins);
+        channel.synthesisPhaseValid = true;
+    }
+    else
+    {
+        for (int k = 0; k < numBins; ++k)
+            synthesisPhase[(size_t)k] = SpectralKernels::wrapPhase(synthesisPhase[(size_t)k]
+                                                                   + shiftedBin[(size_t)k] * expectedAdvance);
+    }
+
+    SpectralKernels::fromPolar(shiftedMagnitude.data(), synthesisPhase.data(), fftData.data(), numBins);
+}
@@ -1,32 +1,111 @@
-// Core/SpectralProcessor.h
-#pragma once
-#include <JuceHeader.h>
-
-class SpectralProcessor
-{
-public:
-    SpectralProcessor();
-    
-    // FFT operations
-    void analyzeBuffer(const juce::AudioBuffer<float>& input);
-    void resynthesizeToBuffer(juce::AudioBuffer<float>& output);
-    
-    // CDP-style transformations
-    void spectralMask(const FrequencyMask& mask);
-    void spectralStretch(float factor);
-    void spectralShift(float semitones);
-    void morphSpectra(const SpectralData& target, float amount);
-    
-    // Granular operations
-    void granularScatter(const GrainParameters& params);
-    void timeStretchGranular(float factor);
-
-private:
-    static constexpr int fftOrder = 11; // 2048 samples
-    juce::dsp::FFT forwardFFT{fftOrder};
-    juce::dsp::FFT inverseFFT{fftOrder};
-    
-    std::vector<std::complex<float>> frequencyDomain;
-    std::vector<float> magnitudes;
-    std::vector<float> phases;
-};
\ No newline at end of file
+// Core/SpectralProcessor.h
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+// Streaming STFT/ISTFT. Input is cut into windowed frames every hop, each frame
+// is converted to magnitude and phase, transformed, and overlap-added back.
+// With no transformation the output is the input delayed by getLatencySamples().
+//
+// Everything is allocated in prepare(). process() and the transformation
+// setters are real-time safe and belong to the audio thread.
+class SpectralProcessor
+{
+public:
+    enum class Window
+    {
+        Hann = 0,
+        Hamming,
+        BlackmanHarris   // 4-term; lowest leakage, widest main lobe
+    };
+
+    struct Settings
+    {
+        int fftOrder = 11;              // 2048-point frames
+        int overlap = 4;                // frames per frame length: hop = fftSize / overlap, 4 = 75%
+        Window window = Window::Hann;
+    };
+
+    // One channel's spectrum, numBins = fftSize / 2 + 1
+    struct Frame
+    {
+        std::vector<float> magnitude;
+        std::vector<float> phase;
+
+        int getNumBins() const { return (int)magnitude.size(); }
+    };
+
+    // Output lags input by one frame, less a sample: a sample's last frame runs as soon as it's in
+    static int getLatencySamples(const Settings& s) { return (1 << s.fftOrder) - 1; }
+
+    SpectralProcessor() = default;
+
+    // Not on the audio thread
+    void prepare(double sampleRate, int maxBlockSize, int numChannels);
+    void prepare(double sampleRate, int maxBlockSize, int numChannels, const Settings& newSettings);
+    void reset();
+
+    const Settings& getSettings() const { return settings; }
+    int getLatencySamples() const { return getLatencySamples(settings); }
+    int getFftSize() const { return fftSize; }
+    int getHopSize() const { return hopSize; }
+    int getNumBins() const { return numBins; }
+
+    // In place, any length
+    void process(juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
+
+    // The halves of process(), for output into another buffer. Each analyzeBuffer() of at most
+    // maxBlockSize samples must be followed by a resynthesizeToBuffer() of the same length.
+    void analyzeBuffer(const juce::AudioBuffer<float>& input, int startSample, int numSamples);
+    void resynthesizeToBuffer(juce::AudioBuffer<float>& output, int startSample, int numSamples);
+
+    // Transformations; all default to off, where frames pass through untouched.
+    // Shift and stretch track each bin's true frequency across frames, as a phase vocoder.
+    void spectralShift(float semitones);                    // every partial by the same ratio
+    void spectralStretch(float factor);                     // f -> ref * (f / ref)^factor, inharmonic above 1
+    void morphSpectra(const Frame& target, float amount);   // magnitudes towards target's, phases kept
+    bool isTransforming() const { return shiftRatio != 1.0f || stretchExponent != 1.0f || morphAmount > 0.0f; }
+
+    // The channel's latest spectrum as analysed, before any transformation
+    const Frame& getLastFrame(int channel) const { return channels[(size_t)channel].analysis; }
+
+private:
+    struct Channel
+    {
+        std::vector<float> input;          // the last fftSize input samples, oldest first
+        std::vector<float> overlapAdd;     // fftSize; the first hop is complete after each frame
+        std::vector<float> output;         // finished samples waiting for resynthesizeToBuffer()
+        Frame analysis;
+        std::vector<float> previousPhase;  // last frame's analysis phase
+        std::vector<float> synthesisPhase; // accumulated output phase while shifting or stretching
+        bool synthesisPhaseValid = false;
+    };
+
+    void processFrame(Channel& channel);
+    void shiftFrame(Channel& channel);
+
+    static constexpr float stretchReferenceHz = 55.0f;   // stretching leaves this frequency alone
+
+    Settings settings;
+    double sampleRate = 44100.0;
+    int fftSize = 0, hopSize = 0, numBins = 0, maxBlockSize = 0;
+
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::vector<float> window;
+    std::vector<float> outputGain;   // hop-periodic; undoes the summed squared windows
+    std::vector<float> fftData;      // 2 * fftSize, as the real-only transforms want
+    std::vector<float> shiftedMagnitude, shiftedBin, morphTarget;
+
+    std::vector<Channel> channels;
+    int hopFill = 0;      // input samples since the last frame
+    int numOutput = 0;    // samples waiting in every channel's output
+
+    float shiftRatio = 1.0f;
+    float stretchExponent = 1.0f;
+    float morphAmount = 0.0f;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectralProcessor)
+};
@@ -0,0 +1,141 @@
+#include "SpectralProcessor.h"
+#include <JuceHeader.h>
+#include <cmath>
+
+/**
+ * Latency tests for SpectralProcessor.
+ * The master insert reports getLatencySamples() to the host and fades between
+ * the dry mix and its output, so with nothing transformed its output has to be
+ * exactly the input, that many samples late.
+ */
+class SpectralProcessorTest
+{
+public:
+    static bool runBasicTests()
+    {
+        DBG("=== SpectralProcessor Latency Tests ===");
+
+        // Test 1: Untransformed, process() delays by fftSize - 1 and changes nothing else
+        if (!testIdentityInPlace())
+            return false;
+
+        // Test 2: The same through analyzeBuffer() and resynthesizeToBuffer(), after a reset
+        if (!testIdentityAfterReset())
+            return false;
+
+        DBG("=== All SpectralProcessor tests passed! ===");
+        return true;
+    }
+
+private:
+    static constexpr double sampleRate = 44100.0;
+    static constexpr int maxBlockSize = 512;
+    static constexpr int numSamples = 20000;
+    static constexpr float tolerance = 1.0e-4f;   // float FFT round trip
+
+    static void makeNoise(juce::AudioBuffer<float>& buffer, juce::int64 seed)
+    {
+        juce::Random random(seed);
+        buffer.setSize(2, numSamples);
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample(ch, i, random.nextFloat() * 2.0f - 1.0f);
+    }
+
+    static bool checkDelayed(const juce::AudioBuffer<float>& input, const juce::AudioBuffer<float>& output, int latency)
+    {
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float expected = i >= latency ? input.getSample(ch, i - latency) : 0.0f;
+                const float difference = std::abs(output.getSample(ch, i) - expected);
+
+                if (difference > tolerance)
+                {
+                    DBG("FAIL: Channel " << ch << ", sample " << i << " is " << output.getSample(ch, i)
+                        << ", expected " << expected << " (latency " << latency << ")");
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    static bool testIdentityInPlace()
+    {
+        DBG("Testing untransformed delay in place...");
+
+        SpectralProcessor processor;
+        processor.prepare(sampleRate, maxBlockSize, 2);
+        processor.reset();
+
+        if (processor.getLatencySamples() != processor.getFftSize() - 1)
+        {
+            DBG("FAIL: Latency should be fftSize - 1, is " << processor.getLatencySamples());
+            return false;
+        }
+
+        juce::AudioBuffer<float> input;
+        makeNoise(input, 0x5bec);
+
+        juce::AudioBuffer<float> output;
+        output.makeCopyOf(input);
+
+        // Uneven blocks, some longer than maxBlockSize, so hops and blocks never line up
+        const int blockSizes[] = { 37, 512, 1, 700, 128, 333 };
+        for (int start = 0, b = 0; start < numSamples; ++b)
+        {
+            const int num = juce::jmin(blockSizes[b % 6], numSamples - start);
+            processor.process(output, start, num);
+            start += num;
+        }
+
+        if (!checkDelayed(input, output, processor.getLatencySamples()))
+            return false;
+
+        DBG("✓ In-place delay test passed");
+        return true;
+    }
+
+    static bool testIdentityAfterReset()
+    {
+        DBG("Testing untransformed delay after a reset...");
+
+        SpectralProcessor processor;
+        processor.prepare(sampleRate, maxBlockSize, 2);
+        processor.reset();
+
+        // Leave some other material behind, then start over as the insert does when switched on
+        juce::AudioBuffer<float> input;
+        makeNoise(input, 0xd1ff);
+        processor.spectralShift(5.0f);
+        processor.process(input, 0, 3000);
+
+        processor.spectralShift(0.0f);
+        processor.reset();
+
+        makeNoise(input, 0x5eed);
+        juce::AudioBuffer<float> output(2, numSamples);
+
+        for (int start = 0; start < numSamples; start += 300)
+        {
+            const int num = juce::jmin(300, numSamples - start);
+            processor.analyzeBuffer(input, start, num);
+            processor.resynthesizeToBuffer(output, start, num);
+        }
+
+        if (!checkDelayed(input, output, processor.getLatencySamples()))
+            return false;
+
+        DBG("✓ Reset delay test passed");
+        return true;
+    }
+};
+
+// Function to run tests (can be called from main application for validation)
+bool testSpectralProcessor()
+{
+    return SpectralProcessorTest::runBasicTests();
+}
@@ -0,0 +1,239 @@
+// Core/SpectrogramAnalyzer.cpp
+#include "SpectrogramAnalyzer.h"
+#include "TiledCanvas.h"
+#include <atomic>
+#include <cmath>
+
+SpectrogramAnalyzer::SpectrogramAnalyzer()
+    : workers(juce::jmax(1, juce::SystemStats::getNumCpus()))
+{
+    formatManager.registerBasicFormats();
+}
+
+SpectrogramAnalyzer::~SpectrogramAnalyzer()
+{
+    workers.removeAllJobs(true, 5000);
+}
+
+std::unique_ptr<juce::AudioFormatReader> SpectrogramAnalyzer::createReader(const juce::File& file)
+{
+    if (!file.existsAsFile())
+        return nullptr;
+
+    std::unique_ptr<juce::AudioFormatReader> r(formatManager.createReaderFor(file));
+    if (r == nullptr || r->lengthInSamples <= 0 || r->numChannels == 0)
+        return nullptr;
+
+    return r;
+}
+
+bool SpectrogramAnalyzer::loadAudio(juce::AudioFormatReader& reader, juce::AudioBuffer<float>& dest)
+{
+    dest.setSize(juce::jmin(2, (int)reader.numChannels), (int)reader.lengthInSamples);
+    return reader.read(&dest, 0, dest.getNumSamples(), 0, true, true);
+}
+
+int SpectrogramAnalyzer::getNumColumns(juce::int64 numSamples, const Settings& settings) const
+{
+    return (int)((numSamples + settings.hopSize - 1) / settings.hopSize);
+}
+
+//==============================================================================
+bool SpectrogramAnalyzer::analyze(const juce::AudioBuffer<float>& audio, double sampleRate, const Settings& settings,
+                                  CanvasProcessor::PreparedImage& dest)
+{
+    const int numColumns = getNumColumns(audio.getNumSamples(), settings);
+    if (numColumns == 0 || audio.getNumChannels() == 0 || settings.numRows > CanvasProcessor::maxPartials)
+        return false;
+
+    prepareBands(sampleRate, settings);
+
+    dest.tiles.reset();
+    dest.width = numColumns;
+    dest.numRows = settings.numRows;
+    dest.sourceHeight = settings.numRows;
+    dest.rowStep = 1;
+    dest.amplitude.assign((size_t)numColumns * (size_t)settings.numRows, 0.0f);
+    dest.pan.assign((size_t)numColumns * (size_t)settings.numRows, 0.5f);
+
+    analyzeColumns(audio, 0, settings, 0, numColumns, dest.amplitude.data(), dest.pan.data());
+    dest.findRuns();
+    return true;
+}
+
+bool SpectrogramAnalyzer::analyzeToTiles(juce::AudioFormatReader& reader, const Settings& settings, const juce::File& tileFile)
+{
+    const auto numSamples = reader.lengthInSamples;
+    const int numColumns = getNumColumns(numSamples, settings);
+    if (numColumns == 0 || reader.numChannels == 0)
+        return false;
+
+    CanvasTileWriter writer;
+    if (!writer.begin(tileFile, settings.numRows, settings.numRows, 1))
+        return false;
+
+    prepareBands(reader.sampleRate, settings);
+
+    // A chunk is enough work to keep every worker busy, and it and its audio are all that's held in memory
+    const int fftSize = 1 << settings.fftOrder;
+    const int chunkColumns = juce::jmax(1, workers.getNumThreads()) * columnsPerJob * 4;
+    std::vector<float> amplitude((size_t)chunkColumns * (size_t)settings.numRows);
+    std::vector<float> pan(amplitude.size());
+
+    const int numChannels = juce::jmin(2, (int)reader.numChannels);
+    juce::AudioBuffer<float> audio(numChannels, (chunkColumns - 1) * settings.hopSize + fftSize);
+
+    for (int first = 0; first < numColumns; first += chunkColumns)
+    {
+        const int num = juce::jmin(chunkColumns, numColumns - first);
+
+        // The samples under this chunk's frames, which are centred on their columns
+        const auto from = juce::jmax((juce::int64)0, (juce::int64)first * settings.hopSize - fftSize / 2);
+        const auto to = juce::jmin(numSamples, (juce::int64)(first + num - 1) * settings.hopSize + fftSize / 2);
+
+        audio.setSize(numChannels, (int)(to - from), false, false, true);
+        if (!reader.read(&audio, 0, audio.getNumSamples(), from, true, true))
+            return false;
+
+        analyzeColumns(audio, (int)from, settings, first, num, amplitude.data(), pan.data());
+
+        for (int c = 0; c < num; ++c)
+            if (!writer.addColumn(amplitude.data() + (size_t)c * (size_t)settings.numRows,
+                                  pan.data() + (size_t)c * (size_t)settings.numRows))
+                return false;
+    }
+
+    return writer.finish();
+}
+
+//==============================================================================
+void SpectrogramAnalyzer::prepareBands(double sampleRate, const Settings& settings)
+{
+    const int fftSize = 1 << settings.fftOrder;
+
+    // Hann
+    window.resize((size_t)fftSize);
+    for (int i = 0; i < fftSize; ++i)
+        window[(size_t)i] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * (float)i / (float)fftSize);
+
+    // Same law as CanvasProcessor::pixelYToFrequency: row 0 is the top, highest frequency
+    const int numRows = settings.numRows;
+    const float logMin = std::log(settings.minFreq);
+    const float logMax = std::log(settings.maxFreq);
+    auto rowToLogFrequency = [=](float row) { return logMin + (1.0f - row / (float)numRows) * (logMax - logMin); };
+
+    const float binsPerHz = (float)fftSize / (float)sampleRate;
+    const int lastBin = fftSize / 2;
+    bands.resize((size_t)numRows);
+
+    for (int row = 0; row < numRows; ++row)
+    {
+        auto& band = bands[(size_t)row];
+        const float centre = std::exp(rowToLogFrequency((float)row)) * binsPerHz;
+        const float upper  = std::exp(rowToLogFrequency((float)row - 0.5f)) * binsPerHz;
+        const float lower  = std::exp(rowToLogFrequency((float)row + 0.5f)) * binsPerHz;
+
+        band.centreBin = juce::jlimit(0.0f, (float)lastBin, centre);
+        band.firstBin = juce::jlimit(0, lastBin, (int)std::ceil(lower));
+        band.lastBin = juce::jlimit(0, lastBin, (int)std::floor(upper));
+        band.interpolate = band.lastBin <= band.firstBin;
+    }
+}
+
+void SpectrogramAnalyzer::analyzeColumns(const juce::AudioBuffer<float>& audio, int audioStart, const Settings& settings,
+                                         int firstColumn, int numColumns, float* amplitude, float* pan)
+{
+    std::atomic<int> remaining{ (numColumns + columnsPerJob - 1) / columnsPerJob };
+    juce::WaitableEvent done;
+
+    for (int first = 0; first < numColumns; first += columnsPerJob)
+    {
+        const int num = juce::jmin(columnsPerJob, numColumns - first);
+        const size_t offset = (size_t)first * (size_t)settings.numRows;
+
+        workers.addJob([this, &audio, &settings, &remaining, &done, audioStart, first, num, firstColumn,
+                        amplitude = amplitude + offset, pan = pan + offset]
+        {
+            analyzeJob(audio, audioStart, settings, firstColumn + first, num, amplitude, pan);
+
+            if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                done.signal();
+        });
+    }
+
+    done.wait();
+}
+
+void SpectrogramAnalyzer::analyzeJob(const juce::AudioBuffer<float>& audio, int audioStart, const Settings& settings,
+                                     int firstColumn, int numColumns, float* amplitude, float* pan) const
+{
+    const int fftSize = 1 << settings.fftOrder;
+    const int numRows = settings.numRows;
+    const int audioEnd = audioStart + audio.getNumSamples();
+    const int numChannels = juce::jmin(2, audio.getNumChannels());
+
+    // Each job has its own transform and scratch, so nothing is shared but the input
+    juce::dsp::FFT fft(settings.fftOrder);
+    std::vector<float> frame((size_t)fftSize * 2);
+    std::vector<float> rowAmplitude[2] = { std::vector<float>((size_t)numRows), std::vector<float>((size_t)numRows) };
+
+    // A Hann-windowed sinusoid of amplitude A peaks at A * fftSize / 4
+    const float magnitudeToAmplitude = 4.0f / (float)fftSize;
+
+    for (int c = 0; c < numColumns; ++c)
+    {
+        // Frames are centred on their column
+        const int start = (firstColumn + c) * settings.hopSize - fftSize / 2;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            std::fill(frame.begin(), frame.end(), 0.0f);
+
+            const int from = juce::jmax(audioStart, start);
+            const int to = juce::jmin(audioEnd, start + fftSize);
+            if (to > from)
+                juce::FloatVectorOperations::multiply(frame.data() + (from - start), audio.getReadPointer(ch, from - audioStart),
+                                                      window.data() + (from - start), to - from);
+
+            fft.performFrequencyOnlyForwardTransform(frame.data(), true);
+
+            auto& rows = rowAmplitude[ch];
+            for (int row = 0; row < numRows; ++row)
+            {
+                const auto& band = bands[(size_t)row];
+                float magnitude;
+
+                if (band.interpolate)
+                {
+                    const int bin = juce::jmin((int)band.centreBin, fftSize / 2 - 1);
+                    const float t = band.centreBin - (float)bin;
+                    magnitude = frame[(size_t)bin] + t * (frame[(size_t)bin + 1] - frame[(size_t)bin]);
+                }
+                else
+                {
+                    magnitude = *std::max_element(frame.begin() + band.firstBin, frame.begin() + band.lastBin + 1);
+                }
+
+                rows[(size_t)row] = magnitude * magnitudeToAmplitude;
+            }
+        }
+
+        // Mono plays equally from both sides
+        if (numChannels == 1)
+            rowAmplitude[1] = rowAmplitude[0];
+
+        float* columnAmplitude = amplitude + (size_t)c * (size_t)numRows;
+        float* columnPan = pan + (size_t)c * (size_t)numRows;
+
+        // The canvas plays a partial at amplitude * (1 - pan) left and amplitude * pan right
+        for (int row = 0; row < numRows; ++row)
+        {
+            const float left = rowAmplitude[0][(size_t)row];
+            const float right = rowAmplitude[1][(size_t)row];
+            const float sum = left + right;
+
+            columnAmplitude[row] = sum >= silenceFloor ? juce::jmin(1.0f, sum) : 0.0f;
+            columnPan[row] = sum >= silenceFloor ? right / sum : 0.5f;
+        }
+    }
+}
@@ -0,0 +1,73 @@
+// Core/SpectrogramAnalyzer.h
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <vector>
+#include "CanvasProcessor.h"
+
+//==============================================================================
+// Renders audio into a canvas: one column per STFT frame, one row per
+// log-spaced partial, using the same row-to-frequency law as CanvasProcessor.
+// Amplitudes are sinusoid amplitudes and pan comes from the left/right
+// balance, so playing the canvas back resynthesises the material.
+//
+// Frames are independent, so they are spread across a pool of workers.
+// Everything here blocks; call it off the message and audio threads.
+class SpectrogramAnalyzer
+{
+public:
+    struct Settings
+    {
+        int   fftOrder = 11;                                // 2048-point frames
+        int   hopSize = 512;
+        int   numRows = CanvasProcessor::maxPartials;
+        float minFreq = 20.0f;                              // match the canvas frequency range
+        float maxFreq = 20000.0f;
+    };
+
+    SpectrogramAnalyzer();
+    ~SpectrogramAnalyzer();
+
+    // Null for a file no registered format can read, or one with no samples
+    std::unique_ptr<juce::AudioFormatReader> createReader(const juce::File& file);
+    // Decodes the whole of reader into dest; the first two channels at most
+    bool loadAudio(juce::AudioFormatReader& reader, juce::AudioBuffer<float>& dest);
+
+    int getNumColumns(juce::int64 numSamples, const Settings& settings) const;
+
+    // Into memory, runs included
+    bool analyze(const juce::AudioBuffer<float>& audio, double sampleRate, const Settings& settings,
+                 CanvasProcessor::PreparedImage& dest);
+
+    // Into a tile file, decoding and analysing a chunk at a time, so memory stays bounded
+    // however long the audio is
+    bool analyzeToTiles(juce::AudioFormatReader& reader, const Settings& settings, const juce::File& tileFile);
+
+private:
+    // Which FFT bins feed a row: the largest bin in [firstBin, lastBin], or, where rows are
+    // closer together than bins, interpolated at centreBin
+    struct RowBand
+    {
+        int firstBin = 0, lastBin = 0;
+        float centreBin = 0.0f;
+        bool interpolate = false;
+    };
+
+    void prepareBands(double sampleRate, const Settings& settings);
+    // audio holds the source from sample audioStart on, as far as the columns reach or the source ends
+    void analyzeColumns(const juce::AudioBuffer<float>& audio, int audioStart, const Settings& settings,
+                        int firstColumn, int numColumns, float* amplitude, float* pan);
+    void analyzeJob(const juce::AudioBuffer<float>& audio, int audioStart, const Settings& settings,
+                    int firstColumn, int numColumns, float* amplitude, float* pan) const;
+
+    static constexpr int columnsPerJob = 64;
+    static constexpr float silenceFloor = 1.0e-4f;   // -80 dB; quieter rows stay black
+
+    juce::AudioFormatManager formatManager;
+    juce::ThreadPool workers;
+    std::vector<float> window;
+    std::vector<RowBand> bands;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrogramAnalyzer)
+};
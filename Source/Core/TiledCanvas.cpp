@@ -0,0 +1,317 @@
+// Core/TiledCanvas.cpp
+#include "TiledCanvas.h"
+#include <limits>
+
+//==============================================================================
+void CanvasRun::find(const float* amplitude, int numRows, std::vector<CanvasRun>& runs)
+{
+    for (int row = 0; row < numRows;)
+    {
+        if (amplitude[row] <= 0.0f)
+        {
+            ++row;
+            continue;
+        }
+
+        const int first = row;
+        while (row < numRows && amplitude[row] > 0.0f)
+            ++row;
+
+        runs.push_back({ (juce::uint16)first, (juce::uint16)(row - first) });
+    }
+}
+
+//==============================================================================
+bool CanvasTileWriter::begin(const juce::File& file, int numRows, int sourceHeight, int rowStep)
+{
+    finish();
+
+    if (numRows <= 0)
+        return false;
+
+    stream = std::make_unique<juce::FileOutputStream>(file);
+    if (!stream->openedOk())
+    {
+        stream.reset();
+        return false;
+    }
+
+    stream->setPosition(0);
+    stream->truncate();
+
+    header = {};
+    header.numRows = numRows;
+    header.sourceHeight = sourceHeight;
+    header.rowStep = rowStep;
+    tile.assign(CanvasTileFormat::getTileFloats(numRows), 0.0f);
+    columnsInTile = 0;
+    failed = false;
+
+    // The header goes in last, once the width is known; keep its page for now
+    failed = !stream->writeRepeatedByte(0, (size_t)CanvasTileFormat::tileAlignment);
+    return !failed;
+}
+
+bool CanvasTileWriter::addColumn(const float* amplitude, const float* pan)
+{
+    if (stream == nullptr || failed)
+        return false;
+
+    const size_t numRows = (size_t)header.numRows;
+    const size_t offset = (size_t)columnsInTile * numRows;
+    std::copy(amplitude, amplitude + numRows, tile.begin() + (std::ptrdiff_t)offset);
+    std::copy(pan, pan + numRows, tile.begin() + (std::ptrdiff_t)(CanvasTileFormat::tileColumns * numRows + offset));
+
+    ++header.width;
+    if (++columnsInTile == CanvasTileFormat::tileColumns)
+        return writeTile();
+
+    return true;
+}
+
+bool CanvasTileWriter::writeTile()
+{
+    const auto dataBytes = tile.size() * sizeof(float);
+    const auto padding = (size_t)CanvasTileFormat::getTileBytes(header.numRows) - dataBytes;
+
+    failed = failed || !stream->write(tile.data(), dataBytes) || !stream->writeRepeatedByte(0, padding);
+
+    std::fill(tile.begin(), tile.end(), 0.0f);
+    columnsInTile = 0;
+    return !failed;
+}
+
+bool CanvasTileWriter::finish()
+{
+    if (stream == nullptr)
+        return false;
+
+    if (columnsInTile > 0)
+        writeTile();
+
+    failed = failed || !stream->setPosition(0) || !stream->write(&header, sizeof(header));
+    stream->flush();
+    failed = failed || stream->getStatus().failed();
+
+    stream.reset();
+    tile = {};
+    return !failed;
+}
+
+//==============================================================================
+TiledCanvas::~TiledCanvas()
+{
+    close();
+}
+
+bool TiledCanvas::open(const juce::File& file, bool deleteFileWhenClosed)
+{
+    close();
+
+    stream = std::make_unique<juce::FileInputStream>(file);
+    CanvasTileFormat::Header h;
+
+    const bool valid = stream->openedOk()
+                       && stream->read(&h, (int)sizeof(h)) == (int)sizeof(h)
+                       && h.magic == CanvasTileFormat::magic
+                       && h.version == CanvasTileFormat::version
+                       && h.tileColumns == CanvasTileFormat::tileColumns
+                       && h.width > 0 && h.numRows > 0 && h.rowStep > 0;
+
+    if (!valid)
+    {
+        stream.reset();
+        return false;
+    }
+
+    header = h;
+
+    // A truncated file would only ever load part of its tiles
+    if (stream->getTotalLength() < CanvasTileFormat::getTileOffset(getNumTiles(), header.numRows))
+    {
+        stream.reset();
+        header = {};
+        return false;
+    }
+
+    for (auto& slot : slots)
+    {
+        slot.data.assign(CanvasTileFormat::getTileFloats(header.numRows), 0.0f);
+        slot.runs.clear();
+        slot.columnRuns.assign(CanvasTileFormat::tileColumns + 1, 0);
+        slot.tile.store(-1, std::memory_order_relaxed);
+        slot.pins.store(-1, std::memory_order_relaxed);
+    }
+
+    playheadTile.store(0, std::memory_order_relaxed);
+    missedColumns.store(0, std::memory_order_relaxed);
+    if (deleteFileWhenClosed)
+        fileToDelete = file;
+
+    prefetcher = std::make_unique<Prefetcher>(*this);
+    prefetcher->startThread(juce::Thread::Priority::high);
+    return true;
+}
+
+void TiledCanvas::close()
+{
+    if (prefetcher != nullptr)
+    {
+        prefetcher->signalThreadShouldExit();
+        prefetcher->wakeUp.signal();
+        prefetcher->stopThread(2000);
+        prefetcher.reset();
+    }
+
+    stream.reset();
+    header = {};
+
+    if (fileToDelete != juce::File())
+    {
+        fileToDelete.deleteFile();
+        fileToDelete = juce::File();
+    }
+}
+
+//==============================================================================
+void TiledCanvas::setPlayheadColumn(int column) noexcept
+{
+    const int tile = juce::jlimit(0, juce::jmax(0, getNumTiles() - 1), column / CanvasTileFormat::tileColumns);
+
+    // Only wake the prefetcher when the playhead crosses into another tile; WakeSignal never locks
+    if (playheadTile.exchange(tile, std::memory_order_relaxed) != tile && prefetcher != nullptr)
+        prefetcher->wakeUp.signal();
+}
+
+TiledCanvas::ColumnView TiledCanvas::acquireColumn(int column) noexcept
+{
+    if (!juce::isPositiveAndBelow(column, header.width))
+        return {};
+
+    const int tile = column / CanvasTileFormat::tileColumns;
+    const size_t numRows = (size_t)header.numRows;
+    const int columnInTile = column % CanvasTileFormat::tileColumns;
+    const size_t offset = (size_t)columnInTile * numRows;
+
+    for (int i = 0; i < numCachedTiles; ++i)
+    {
+        auto& slot = slots[(size_t)i];
+        int pins = slot.pins.load(std::memory_order_acquire);
+
+        if (pins < 0 || slot.tile.load(std::memory_order_relaxed) != tile
+            || !slot.pins.compare_exchange_strong(pins, pins + 1, std::memory_order_acquire))
+            continue;
+
+        // The slot may have been refilled between the checks; pinned, it can't change again
+        if (slot.tile.load(std::memory_order_relaxed) != tile)
+        {
+            slot.pins.fetch_sub(1, std::memory_order_release);
+            continue;
+        }
+
+        const float* data = slot.data.data();
+        const auto firstRun = slot.columnRuns[(size_t)columnInTile];
+        const auto endRun = slot.columnRuns[(size_t)columnInTile + 1];
+
+        return { data + offset, data + (size_t)CanvasTileFormat::tileColumns * numRows + offset,
+                 slot.runs.data() + firstRun, (int)(endRun - firstRun), i };
+    }
+
+    missedColumns.fetch_add(1, std::memory_order_relaxed);
+    return {};
+}
+
+void TiledCanvas::releaseColumn(const ColumnView& view) noexcept
+{
+    if (view.slot >= 0)
+        slots[(size_t)view.slot].pins.fetch_sub(1, std::memory_order_release);
+}
+
+//==============================================================================
+bool TiledCanvas::isResident(int tile) const noexcept
+{
+    for (const auto& slot : slots)
+        if (slot.tile.load(std::memory_order_relaxed) == tile && slot.pins.load(std::memory_order_acquire) >= 0)
+            return true;
+
+    return false;
+}
+
+bool TiledCanvas::loadTile(int tile, int currentTile)
+{
+    const int numTiles = getNumTiles();
+
+    // Empty slots first, then whichever tile the playhead will reach last.
+    // Tiles inside the lookahead window and pinned tiles stay put.
+    int victim = -1;
+    int furthest = -1;
+
+    for (int i = 0; i < numCachedTiles; ++i)
+    {
+        const auto& slot = slots[(size_t)i];
+        const int resident = slot.tile.load(std::memory_order_relaxed);
+        const int distance = resident < 0 ? std::numeric_limits<int>::max()
+                                          : (resident - currentTile + numTiles) % numTiles;
+
+        if (slot.pins.load(std::memory_order_relaxed) > 0 || distance < lookaheadTiles)
+            continue;
+
+        if (distance > furthest)
+        {
+            furthest = distance;
+            victim = i;
+        }
+    }
+
+    if (victim < 0)
+        return false;
+
+    auto& slot = slots[(size_t)victim];
+
+    // Take it away from the audio thread; if a reader pinned it meanwhile, try again later
+    int unpinned = 0;
+    if (slot.tile.load(std::memory_order_relaxed) >= 0
+        && !slot.pins.compare_exchange_strong(unpinned, -1, std::memory_order_acquire))
+        return false;
+
+    slot.tile.store(-1, std::memory_order_relaxed);
+
+    const auto numBytes = slot.data.size() * sizeof(float);
+    if (!stream->setPosition(CanvasTileFormat::getTileOffset(tile, header.numRows))
+        || stream->read(slot.data.data(), (int)numBytes) != (int)numBytes)
+        return false;
+
+    slot.runs.clear();
+    for (int c = 0; c < CanvasTileFormat::tileColumns; ++c)
+    {
+        slot.columnRuns[(size_t)c] = (juce::uint32)slot.runs.size();
+        CanvasRun::find(slot.data.data() + (size_t)c * (size_t)header.numRows, header.numRows, slot.runs);
+    }
+    slot.columnRuns[CanvasTileFormat::tileColumns] = (juce::uint32)slot.runs.size();
+
+    slot.tile.store(tile, std::memory_order_relaxed);
+    slot.pins.store(0, std::memory_order_release);
+    return true;
+}
+
+void TiledCanvas::Prefetcher::run()
+{
+    while (!threadShouldExit())
+    {
+        const int current = canvas.playheadTile.load(std::memory_order_relaxed);
+        const int numTiles = canvas.getNumTiles();
+
+        for (int k = 0; k < juce::jmin(lookaheadTiles, numTiles) && !threadShouldExit(); ++k)
+        {
+            const int tile = (current + k) % numTiles;
+            if (!canvas.isResident(tile) && !canvas.loadTile(tile, current))
+                break;
+
+            // Start again from wherever the playhead went
+            if (canvas.playheadTile.load(std::memory_order_relaxed) != current)
+                break;
+        }
+
+        wakeUp.wait(50);
+    }
+}
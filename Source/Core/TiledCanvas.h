@@ -0,0 +1,163 @@
+// Core/TiledCanvas.h
+#pragma once
+
+#include <JuceHeader.h>
+#include "WakeSignal.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+// Rows [firstRow, firstRow + numRows) of a column that have any amplitude.
+// Most canvases are largely black, so synthesis only visits these.
+struct CanvasRun
+{
+    juce::uint16 firstRow = 0;
+    juce::uint16 numRows = 0;
+
+    // Appends the runs of one column to runs
+    static void find(const float* amplitude, int numRows, std::vector<CanvasRun>& runs);
+};
+
+//==============================================================================
+// A canvas too large to hold in memory, kept on disk as tiles of columns.
+//
+// File layout, native-endian floats:
+//   header, padded to tileAlignment bytes
+//   tile 0, tile 1, ...  each tileColumns columns of amplitude [column][row],
+//                        then the same for pan, padded to tileAlignment bytes
+// The last tile is zero-padded. Tiles start on page boundaries, so a reader
+// may map them instead of streaming them.
+struct CanvasTileFormat
+{
+    static constexpr juce::uint32 magic = 0x4c544341;   // "ACTL"
+    static constexpr juce::uint32 version = 1;
+    static constexpr int tileColumns = 256;
+    static constexpr int tileAlignment = 4096;
+
+    struct Header
+    {
+        juce::uint32 magic = CanvasTileFormat::magic;
+        juce::uint32 version = CanvasTileFormat::version;
+        juce::int32  width = 0;            // columns
+        juce::int32  numRows = 0;          // partials per column
+        juce::int32  sourceHeight = 0;     // pixel rows the partials were taken from
+        juce::int32  rowStep = 1;          // source rows per partial
+        juce::int32  tileColumns = CanvasTileFormat::tileColumns;
+        juce::int32  reserved = 0;
+    };
+
+    static size_t getTileFloats(int numRows) noexcept   { return (size_t)tileColumns * (size_t)numRows * 2; }
+    static juce::int64 getTileBytes(int numRows) noexcept
+    {
+        const auto bytes = (juce::int64)(getTileFloats(numRows) * sizeof(float));
+        return (bytes + tileAlignment - 1) / tileAlignment * tileAlignment;
+    }
+    static juce::int64 getTileOffset(int tile, int numRows) noexcept { return tileAlignment + tile * getTileBytes(numRows); }
+};
+
+//==============================================================================
+// Writes a tile file a column at a time, holding one tile in memory
+class CanvasTileWriter
+{
+public:
+    CanvasTileWriter() = default;
+    ~CanvasTileWriter() { finish(); }
+
+    bool begin(const juce::File& file, int numRows, int sourceHeight, int rowStep);
+    bool addColumn(const float* amplitude, const float* pan);
+    bool finish();   // flushes the last tile and records the width
+
+    int getNumColumns() const noexcept { return header.width; }
+
+private:
+    bool writeTile();
+
+    std::unique_ptr<juce::FileOutputStream> stream;
+    CanvasTileFormat::Header header;
+    std::vector<float> tile;
+    int columnsInTile = 0;
+    bool failed = false;
+
+    JUCE_DECLARE_NON_COPYABLE(CanvasTileWriter)
+};
+
+//==============================================================================
+// Reads a tile file through a fixed set of cached tiles. A prefetch thread
+// keeps the tiles just ahead of the playhead resident, so memory stays the
+// same however long the canvas is.
+//
+// The audio thread pins a tile while it reads a column and never waits:
+// a column whose tile isn't loaded yet is reported missing.
+class TiledCanvas
+{
+public:
+    static constexpr int numCachedTiles = 8;
+    static constexpr int lookaheadTiles = 4;   // resident from the playhead's tile onwards
+
+    TiledCanvas() = default;
+    ~TiledCanvas();
+
+    // Message thread: reads the header and starts prefetching from column 0.
+    // A scratch file (an analysis render, say) can be deleted once the canvas is done with it.
+    bool open(const juce::File& file, bool deleteFileWhenClosed = false);
+    void close();
+
+    int getWidth() const noexcept        { return header.width; }
+    int getNumRows() const noexcept      { return header.numRows; }
+    int getSourceHeight() const noexcept { return header.sourceHeight; }
+    int getRowStep() const noexcept      { return header.rowStep; }
+
+    // One column, valid until released; amplitude is null when its tile isn't resident
+    struct ColumnView
+    {
+        const float* amplitude = nullptr;
+        const float* pan = nullptr;
+        const CanvasRun* runs = nullptr;
+        int numRuns = 0;
+        int slot = -1;
+    };
+
+    // Audio thread
+    void setPlayheadColumn(int column) noexcept;
+    ColumnView acquireColumn(int column) noexcept;
+    void releaseColumn(const ColumnView& view) noexcept;
+    int getNumMissedColumns() const noexcept { return missedColumns.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot
+    {
+        std::vector<float> data;
+        std::vector<CanvasRun> runs;            // found when the tile is loaded
+        std::vector<juce::uint32> columnRuns;   // column c's runs are [columnRuns[c], columnRuns[c + 1])
+        std::atomic<int> tile{ -1 };
+        std::atomic<int> pins{ -1 };   // -1 while empty or loading, else how many readers hold it
+    };
+
+    class Prefetcher : public juce::Thread
+    {
+    public:
+        explicit Prefetcher(TiledCanvas& owner) : juce::Thread("Canvas tile prefetch"), canvas(owner) {}
+        void run() override;
+        WakeSignal wakeUp;   // posted from the audio thread
+
+    private:
+        TiledCanvas& canvas;
+    };
+
+    int getNumTiles() const noexcept { return (header.width + CanvasTileFormat::tileColumns - 1) / CanvasTileFormat::tileColumns; }
+    bool isResident(int tile) const noexcept;
+    bool loadTile(int tile, int playheadTile);   // prefetch thread
+
+    std::unique_ptr<juce::FileInputStream> stream;   // prefetch thread
+    juce::File fileToDelete;
+    CanvasTileFormat::Header header;
+    std::array<Slot, numCachedTiles> slots;
+    std::unique_ptr<Prefetcher> prefetcher;
+
+    std::atomic<int> playheadTile{ 0 };
+    std::atomic<int> missedColumns{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TiledCanvas)
+};
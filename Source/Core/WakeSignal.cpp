@@ -0,0 +1,104 @@
+// Core/WakeSignal.cpp
+#include "WakeSignal.h"
+
+#if JUCE_WINDOWS
+ #ifndef NOMINMAX
+  #define NOMINMAX
+ #endif
+ #ifndef WIN32_LEAN_AND_MEAN
+  #define WIN32_LEAN_AND_MEAN
+ #endif
+ #include <windows.h>
+#elif JUCE_MAC || JUCE_IOS
+ #include <mach/mach.h>
+#else
+ #include <semaphore.h>
+ #include <cerrno>
+ #include <ctime>
+#endif
+
+//==============================================================================
+#if JUCE_WINDOWS
+
+struct WakeSignal::Impl
+{
+    HANDLE semaphore = CreateSemaphoreW(nullptr, 0, 0x7fffffff, nullptr);
+    ~Impl() { CloseHandle(semaphore); }
+};
+
+void WakeSignal::signal() noexcept
+{
+    ReleaseSemaphore(impl->semaphore, 1, nullptr);
+}
+
+bool WakeSignal::wait(int timeoutMs) noexcept
+{
+    return WaitForSingleObject(impl->semaphore, (DWORD)timeoutMs) == WAIT_OBJECT_0;
+}
+
+//==============================================================================
+#elif JUCE_MAC || JUCE_IOS
+
+struct WakeSignal::Impl
+{
+    semaphore_t semaphore{};
+    Impl() { semaphore_create(mach_task_self(), &semaphore, SYNC_POLICY_FIFO, 0); }
+    ~Impl() { semaphore_destroy(mach_task_self(), semaphore); }
+};
+
+void WakeSignal::signal() noexcept
+{
+    semaphore_signal(impl->semaphore);
+}
+
+bool WakeSignal::wait(int timeoutMs) noexcept
+{
+    const mach_timespec_t timeout{ (unsigned int)(timeoutMs / 1000), (clock_res_t)((timeoutMs % 1000) * 1000000) };
+    return semaphore_timedwait(impl->semaphore, timeout) == KERN_SUCCESS;
+}
+
+//==============================================================================
+#else
+
+struct WakeSignal::Impl
+{
+    sem_t semaphore{};
+    Impl() { sem_init(&semaphore, 0, 0); }
+    ~Impl() { sem_destroy(&semaphore); }
+};
+
+void WakeSignal::signal() noexcept
+{
+    sem_post(&impl->semaphore);
+}
+
+bool WakeSignal::wait(int timeoutMs) noexcept
+{
+    timespec deadline{};
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeoutMs / 1000;
+    deadline.tv_nsec += (long)(timeoutMs % 1000) * 1000000L;
+
+    if (deadline.tv_nsec >= 1000000000L)
+    {
+        ++deadline.tv_sec;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    // Retry when a signal handler interrupts the wait
+    int result;
+    while ((result = sem_timedwait(&impl->semaphore, &deadline)) == -1 && errno == EINTR)
+        ;
+
+    return result == 0;
+}
+
+#endif
+
+//==============================================================================
+WakeSignal::WakeSignal()
+    : impl(std::make_unique<Impl>())
+{
+}
+
+WakeSignal::~WakeSignal() = default;
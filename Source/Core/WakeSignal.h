@@ -0,0 +1,32 @@
+// Core/WakeSignal.h
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+
+//==============================================================================
+// A counting semaphore for waking worker threads from the audio thread.
+//
+// signal() never takes a lock or allocates: it maps onto the platform's own
+// semaphore (a futex-backed POSIX semaphore on Linux, a Mach semaphore on
+// macOS, a Win32 semaphore on Windows), which only enters the kernel when a
+// thread is actually asleep on it. juce::WaitableEvent locks a mutex to
+// signal, so it isn't safe to call from the audio callback.
+class WakeSignal
+{
+public:
+    WakeSignal();
+    ~WakeSignal();
+
+    // Any thread, including the audio thread; each call lets one wait() through
+    void signal() noexcept;
+
+    // Returns true once signalled, false after timeoutMs without a signal
+    bool wait(int timeoutMs) noexcept;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+
+    JUCE_DECLARE_NON_COPYABLE(WakeSignal)
+};
@@ -1,157 +1,302 @@
-#include "GUI/CanvasPanel.h"
-#include "GUI/ArtefactLookAndFeel.h"
-
-CanvasPanel::CanvasPanel()
-{
-    // Set up placeholder label
-    placeholderLabel = std::make_unique<juce::Label>("placeholder", "IMAGE CANVAS");
-    placeholderLabel->setFont(juce::Font(juce::Font::getDefaultMonospacedFontName(), 16.0f, juce::Font::plain));
-    placeholderLabel->setColour(juce::Label::textColourId, ArtefactLookAndFeel::kTextColour);
-    placeholderLabel->setJustificationType(juce::Justification::centred);
-    addAndMakeVisible(placeholderLabel.get());
-}
-
-void CanvasPanel::paint(juce::Graphics& g)
-{
-    auto bounds = getLocalBounds();
-
-    // Fill with CRT black
-    g.fillAll(ArtefactLookAndFeel::kBackground);
-
-    // Draw inset bevel around entire panel
-    g.setColour(ArtefactLookAndFeel::kBevelLight);
-    g.drawRect(bounds, 1.0f);
-
-    // Inner content area
-    auto contentBounds = bounds.reduced(4);
-
-    if (hasImage && currentImage.isValid())
-    {
-        // Calculate aspect-correct display bounds
-        auto imageAspect = static_cast<float>(currentImage.getWidth()) /
-            static_cast<float>(currentImage.getHeight());
-        auto panelAspect = static_cast<float>(contentBounds.getWidth()) /
-            static_cast<float>(contentBounds.getHeight());
-
-        if (imageAspect > panelAspect)
-        {
-            // Image is wider - fit to width
-            int displayWidth = contentBounds.getWidth();
-            int displayHeight = static_cast<int>(displayWidth / imageAspect);
-            imageDisplayBounds = juce::Rectangle<float>(
-                static_cast<float>(contentBounds.getX()),
-                static_cast<float>(contentBounds.getCentreY() - displayHeight / 2),
-                static_cast<float>(displayWidth),
-                static_cast<float>(displayHeight)
-            );
-        }
-        else
-        {
-            // Image is taller - fit to height
-            int displayHeight = contentBounds.getHeight();
-            int displayWidth = static_cast<int>(displayHeight * imageAspect);
-            imageDisplayBounds = juce::Rectangle<float>(
-                static_cast<float>(contentBounds.getCentreX() - displayWidth / 2),
-                static_cast<float>(contentBounds.getY()),
-                static_cast<float>(displayWidth),
-                static_cast<float>(displayHeight)
-            );
-        }
-
-        // Draw the image
-        g.setOpacity(1.0f);
-        g.drawImage(currentImage, imageDisplayBounds);
-
-        // Draw scan lines effect for that CRT feel
-        g.setColour(ArtefactLookAndFeel::kBackground.withAlpha(0.3f));
-        for (int y = 0; y < getHeight(); y += 2)
-        {
-            g.drawHorizontalLine(y, 0.0f, static_cast<float>(getWidth()));
-        }
-    }
-    else
-    {
-        // Draw grid pattern when empty
-        g.setColour(ArtefactLookAndFeel::kBevelDark);
-        const int gridSize = 32;
-
-        for (int x = contentBounds.getX(); x < contentBounds.getRight(); x += gridSize)
-        {
-            g.drawVerticalLine(x, static_cast<float>(contentBounds.getY()),
-                static_cast<float>(contentBounds.getBottom()));
-        }
-
-        for (int y = contentBounds.getY(); y < contentBounds.getBottom(); y += gridSize)
-        {
-            g.drawHorizontalLine(y, static_cast<float>(contentBounds.getX()),
-                static_cast<float>(contentBounds.getRight()));
-        }
-    }
-}
-
-void CanvasPanel::resized()
-{
-    if (placeholderLabel && !hasImage)
-    {
-        placeholderLabel->setBounds(getLocalBounds());
-    }
-}
-
-bool CanvasPanel::isInterestedInFileDrag(const juce::StringArray& files)
-{
-    for (auto& file : files)
-    {
-        juce::File f(file);
-        if (f.hasFileExtension("jpg;jpeg;png;gif;bmp"))
-            return true;
-    }
-    return false;
-}
-
-void CanvasPanel::filesDropped(const juce::StringArray& files, int, int)
-{
-    if (files.size() > 0)
-    {
-        loadImage(juce::File(files[0]));
-    }
-}
-
-void CanvasPanel::loadImage(const juce::File& imageFile)
-{
-    currentImage = juce::ImageFileFormat::loadFrom(imageFile);
-    if (currentImage.isValid())
-    {
-        currentImageFile = imageFile;
-        hasImage = true;
-        if (placeholderLabel)
-            placeholderLabel->setVisible(false);
-        repaint();
-    }
-}
-
-void CanvasPanel::clearImage()
-{
-    currentImage = juce::Image();
-    currentImageFile = juce::File();
-    hasImage = false;
-    if (placeholderLabel)
-        placeholderLabel->setVisible(true);
-    repaint();
-}
-
-float CanvasPanel::getBrightnessAt(float normX, float normY) const
-{
-    if (!hasImage || !currentImage.isValid())
-        return 0.0f;
-    
-    // Convert normalized coords to image pixel coords
-    int pixelX = static_cast<int>(normX * currentImage.getWidth());
-    int pixelY = static_cast<int>(normY * currentImage.getHeight());
-    
-    // Clamp to valid range
-    pixelX = juce::jlimit(0, currentImage.getWidth() - 1, pixelX);
-    pixelY = juce::jlimit(0, currentImage.getHeight() - 1, pixelY);
-    
-    auto pixel = currentImage.getPixelAt(pixelX, pixelY);
-    return pixel.getBrightness();
+#include "GUI/CanvasPanel.h"
+#include "GUI/ArtefactLookAndFeel.h"
+
+CanvasPanel::CanvasPanel()
+{
+    // Set up placeholder label
+    placeholderLabel = std::make_unique<juce::Label>("placeholder", "IMAGE CANVAS");
+    placeholderLabel->setFont(juce::Font(juce::Font::getDefaultMonospacedFontName(), 16.0f, juce::Font::plain));
+    placeholderLabel->setColour(juce::Label::textColourId, ArtefactLookAndFeel::kTextColour);
+    placeholderLabel->setJustificationType(juce::Justification::centred);
+    addAndMakeVisible(placeholderLabel.get());
+}
+
+CanvasPanel::~CanvasPanel()
+{
+    decoder.removeAllJobs(true, 2000);
+}
+
+void CanvasPanel::paint(juce::Graphics& g)
+{
+    // Everything is drawn once into the cache at the panel's pixel size; a repaint is a blit
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (!displayCache.isValid() || scale != cacheScale)
+    {
+        cacheScale = scale;
+        renderCache();
+    }
+
+    if (displayCache.isValid())
+        g.drawImage(displayCache, getLocalBounds().toFloat());
+}
+
+void CanvasPanel::renderCache()
+{
+    auto bounds = getLocalBounds();
+    if (bounds.isEmpty())
+    {
+        displayCache = juce::Image();
+        return;
+    }
+
+    displayCache = juce::Image(juce::Image::RGB,
+                               juce::jmax(1, juce::roundToInt(bounds.getWidth() * cacheScale)),
+                               juce::jmax(1, juce::roundToInt(bounds.getHeight() * cacheScale)),
+                               false);
+
+    juce::Graphics g(displayCache);
+    g.addTransform(juce::AffineTransform::scale(cacheScale));
+
+    // Fill with CRT black
+    g.fillAll(ArtefactLookAndFeel::kBackground);
+
+    // Draw inset bevel around entire panel
+    g.setColour(ArtefactLookAndFeel::kBevelLight);
+    g.drawRect(bounds, 1.0f);
+
+    // Inner content area
+    auto contentBounds = bounds.reduced(4);
+
+    if (hasImage && !preview.levels.empty())
+    {
+        // Draw the smallest preview level that still covers the display area
+        const auto& level = preview.getLevelFor(juce::roundToInt(imageDisplayBounds.getWidth() * cacheScale),
+                                                juce::roundToInt(imageDisplayBounds.getHeight() * cacheScale));
+        g.setOpacity(1.0f);
+        g.drawImage(level, imageDisplayBounds);
+
+        // Draw scan lines effect for that CRT feel
+        g.setColour(ArtefactLookAndFeel::kBackground.withAlpha(0.3f));
+        for (int y = 0; y < getHeight(); y += 2)
+        {
+            g.drawHorizontalLine(y, 0.0f, static_cast<float>(getWidth()));
+        }
+    }
+    else
+    {
+        // Draw grid pattern when empty
+        g.setColour(ArtefactLookAndFeel::kBevelDark);
+        const int gridSize = 32;
+
+        for (int x = contentBounds.getX(); x < contentBounds.getRight(); x += gridSize)
+        {
+            g.drawVerticalLine(x, static_cast<float>(contentBounds.getY()),
+                static_cast<float>(contentBounds.getBottom()));
+        }
+
+        for (int y = contentBounds.getY(); y < contentBounds.getBottom(); y += gridSize)
+        {
+            g.drawHorizontalLine(y, static_cast<float>(contentBounds.getX()),
+                static_cast<float>(contentBounds.getRight()));
+        }
+    }
+}
+
+void CanvasPanel::updateDisplayBounds()
+{
+    if (!hasImage || !currentImage.isValid())
+        return;
+
+    auto contentBounds = getLocalBounds().reduced(4);
+
+    // Calculate aspect-correct display bounds
+    auto imageAspect = static_cast<float>(currentImage.getWidth()) /
+        static_cast<float>(currentImage.getHeight());
+    auto panelAspect = static_cast<float>(contentBounds.getWidth()) /
+        static_cast<float>(juce::jmax(1, contentBounds.getHeight()));
+
+    if (imageAspect > panelAspect)
+    {
+        // Image is wider - fit to width
+        int displayWidth = contentBounds.getWidth();
+        int displayHeight = static_cast<int>(displayWidth / imageAspect);
+        imageDisplayBounds = juce::Rectangle<float>(
+            static_cast<float>(contentBounds.getX()),
+            static_cast<float>(contentBounds.getCentreY() - displayHeight / 2),
+            static_cast<float>(displayWidth),
+            static_cast<float>(displayHeight)
+        );
+    }
+    else
+    {
+        // Image is taller - fit to height
+        int displayHeight = contentBounds.getHeight();
+        int displayWidth = static_cast<int>(displayHeight * imageAspect);
+        imageDisplayBounds = juce::Rectangle<float>(
+            static_cast<float>(contentBounds.getCentreX() - displayWidth / 2),
+            static_cast<float>(contentBounds.getY()),
+            static_cast<float>(displayWidth),
+            static_cast<float>(displayHeight)
+        );
+    }
+}
+
+void CanvasPanel::resized()
+{
+    if (placeholderLabel && !hasImage)
+    {
+        placeholderLabel->setBounds(getLocalBounds());
+    }
+
+    updateDisplayBounds();
+    displayCache = juce::Image();
+}
+
+bool CanvasPanel::isInterestedInFileDrag(const juce::StringArray& files)
+{
+    for (auto& file : files)
+    {
+        juce::File f(file);
+        if (f.hasFileExtension("jpg;jpeg;png;gif;bmp"))
+            return true;
+        if (tiledCanvasTarget && f.hasFileExtension(tileFileExtension))
+            return true;
+    }
+    return false;
+}
+
+void CanvasPanel::filesDropped(const juce::StringArray& files, int, int)
+{
+    if (files.size() > 0)
+    {
+        const juce::File file(files[0]);
+
+        if (file.hasFileExtension(tileFileExtension))
+            loadTiledCanvas(file);
+        else
+            loadImage(file);
+    }
+}
+
+void CanvasPanel::loadTiledCanvas(const juce::File& tileFile)
+{
+    if (!tiledCanvasTarget)
+        return;
+
+    // Too big to preview; the canvas plays straight from the file
+    decoder.removeAllJobs(false, 0);
+    clearImage();
+
+    if (tiledCanvasTarget(tileFile) && placeholderLabel)
+        placeholderLabel->setText("TILED CANVAS\n" + tileFile.getFileName(), juce::dontSendNotification);
+}
+
+void CanvasPanel::loadImage(const juce::File& imageFile)
+{
+    // A newer drop replaces anything still waiting to be decoded
+    decoder.removeAllJobs(false, 0);
+
+    const int loadId = ++nextLoadId;
+    pendingLoad = loadId;
+
+    if (placeholderLabel && !hasImage)
+        placeholderLabel->setText("LOADING...", juce::dontSendNotification);
+
+    decoder.addJob([safeThis = juce::Component::SafePointer<CanvasPanel>(this), loadId, imageFile]
+    {
+        auto image = juce::ImageFileFormat::loadFrom(imageFile);
+        auto newPreview = image.isValid() ? buildPreview(image) : Preview();
+
+        juce::MessageManager::callAsync([safeThis, loadId, imageFile, image, newPreview = std::move(newPreview)]() mutable
+        {
+            if (safeThis != nullptr)
+                safeThis->imageDecoded(loadId, imageFile, std::move(image), std::move(newPreview));
+        });
+    });
+}
+
+void CanvasPanel::imageDecoded(int loadId, const juce::File& imageFile, juce::Image image, Preview newPreview)
+{
+    if (loadId != pendingLoad)
+        return;
+
+    pendingLoad = 0;
+
+    if (!image.isValid())
+    {
+        if (placeholderLabel && !hasImage)
+            placeholderLabel->setText("IMAGE CANVAS", juce::dontSendNotification);
+        return;
+    }
+
+    currentImage = std::move(image);
+    currentImageFile = imageFile;
+    preview = std::move(newPreview);
+    hasImage = true;
+    if (placeholderLabel)
+        placeholderLabel->setVisible(false);
+    if (imageTarget)
+        imageTarget(currentImage);
+
+    updateDisplayBounds();
+    displayCache = juce::Image();
+    repaint();
+}
+
+CanvasPanel::Preview CanvasPanel::buildPreview(const juce::Image& source)
+{
+    Preview result;
+    auto level = source;
+
+    const int longestSide = juce::jmax(source.getWidth(), source.getHeight());
+    if (longestSide > maxPreviewSize)
+    {
+        const float scale = (float)maxPreviewSize / (float)longestSide;
+        level = source.rescaled(juce::jmax(1, juce::roundToInt(source.getWidth() * scale)),
+                                juce::jmax(1, juce::roundToInt(source.getHeight() * scale)),
+                                juce::Graphics::highResamplingQuality);
+    }
+
+    result.levels.push_back(level);
+
+    while (juce::jmin(level.getWidth(), level.getHeight()) / 2 >= minPreviewSize)
+    {
+        level = level.rescaled(level.getWidth() / 2, level.getHeight() / 2, juce::Graphics::mediumResamplingQuality);
+        result.levels.push_back(level);
+    }
+
+    return result;
+}
+
+const juce::Image& CanvasPanel::Preview::getLevelFor(int displayWidth, int displayHeight) const
+{
+    // Levels run from largest to smallest
+    for (auto it = levels.rbegin(); it != levels.rend(); ++it)
+        if (it->getWidth() >= displayWidth && it->getHeight() >= displayHeight)
+            return *it;
+
+    return levels.front();
+}
+
+void CanvasPanel::clearImage()
+{
+    pendingLoad = 0;
+    currentImage = juce::Image();
+    currentImageFile = juce::File();
+    preview = Preview();
+    hasImage = false;
+    if (placeholderLabel)
+    {
+        placeholderLabel->setText("IMAGE CANVAS", juce::dontSendNotification);
+        placeholderLabel->setVisible(true);
+    }
+    displayCache = juce::Image();
+    repaint();
+}
+
+float CanvasPanel::getBrightnessAt(float normX, float normY) const
+{
+    if (!hasImage || !currentImage.isValid())
+        return 0.0f;
+    
+    // Convert normalized coords to image pixel coords
+    int pixelX = static_cast<int>(normX * currentImage.getWidth());
+    int pixelY = static_cast<int>(normY * currentImage.getHeight());
+    
+    // Clamp to valid range
+    pixelX = juce::jlimit(0, currentImage.getWidth() - 1, pixelX);
+    pixelY = juce::jlimit(0, currentImage.getHeight() - 1, pixelY);
+    
+    auto pixel = currentImage.getPixelAt(pixelX, pixelY);
+    return pixel.getBrightness();
 }
\ No newline at end of file
@@ -1,41 +1,78 @@
-#pragma once
-
-#include <JuceHeader.h>
-#include <memory>
-
-class CanvasPanel : public juce::Component,
-                    public juce::FileDragAndDropTarget
-{
-public:
-    CanvasPanel();
-    ~CanvasPanel() override = default;
-
-    // Component overrides
-    void paint(juce::Graphics& g) override;
-    void resized() override;
-
-    // FileDragAndDropTarget overrides
-    bool isInterestedInFileDrag(const juce::StringArray& files) override;
-    void filesDropped(const juce::StringArray& files, int x, int y) override;
-
-    // Image loading and management
-    void loadImage(const juce::File& imageFile);
-    void clearImage();
-
-    // Get brightness at normalized position (0-1)
-    float getBrightnessAt(float normX, float normY) const;
-
-private:
-    // Image data
-    juce::Image currentImage;
-    juce::File currentImageFile;
-
-    // Display state
-    bool hasImage{ false };
-    juce::Rectangle<float> imageDisplayBounds;
-
-    // Placeholder text
-    std::unique_ptr<juce::Label> placeholderLabel;
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CanvasPanel)
-};
\ No newline at end of file
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class CanvasPanel : public juce::Component,
+                    public juce::FileDragAndDropTarget
+{
+public:
+    CanvasPanel();
+    ~CanvasPanel() override;
+
+    // Component overrides
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+    // FileDragAndDropTarget overrides
+    bool isInterestedInFileDrag(const juce::StringArray& files) override;
+    void filesDropped(const juce::StringArray& files, int x, int y) override;
+
+    // Image loading and management. Decoding happens on a worker thread;
+    // the panel shows the image once it's ready.
+    void loadImage(const juce::File& imageFile);
+    void clearImage();
+    bool isLoading() const { return pendingLoad != 0; }
+
+    // Receives each decoded image for synthesis (the processor's requestCanvasImage)
+    void setImageTarget(std::function<bool(const juce::Image&)> target) { imageTarget = std::move(target); }
+    // Receives dropped tile files, which are streamed rather than decoded (the processor's requestTiledCanvas)
+    void setTiledCanvasTarget(std::function<bool(const juce::File&)> target) { tiledCanvasTarget = std::move(target); }
+    void loadTiledCanvas(const juce::File& tileFile);
+
+    // Get brightness at normalized position (0-1)
+    float getBrightnessAt(float normX, float normY) const;
+
+private:
+    // Halving steps of the decoded image, from at most maxPreviewSize on the long side
+    // down to about minPreviewSize, so drawing never resamples the full image
+    struct Preview
+    {
+        std::vector<juce::Image> levels;
+        const juce::Image& getLevelFor(int displayWidth, int displayHeight) const;
+    };
+
+    static constexpr const char* tileFileExtension = "actl";   // CanvasTileWriter's output
+    static constexpr int maxPreviewSize = 2048;
+    static constexpr int minPreviewSize = 64;
+    static Preview buildPreview(const juce::Image& source);   // worker thread
+
+    void imageDecoded(int loadId, const juce::File& imageFile, juce::Image image, Preview newPreview);
+    void updateDisplayBounds();
+    void renderCache();
+
+    // Image data
+    juce::Image currentImage;   // full resolution, only read once decoded
+    juce::File currentImageFile;
+    Preview preview;
+    std::function<bool(const juce::Image&)> imageTarget;
+    std::function<bool(const juce::File&)> tiledCanvasTarget;
+
+    // Decoding
+    juce::ThreadPool decoder{ 1 };
+    int nextLoadId = 0;
+    int pendingLoad = 0;   // the load whose result will be shown, 0 for none
+
+    // Display state
+    bool hasImage{ false };
+    juce::Rectangle<float> imageDisplayBounds;
+    juce::Image displayCache;   // the panel as drawn, rebuilt when the image or size changes
+    float cacheScale = 1.0f;    // physical pixels per point the cache was drawn at
+
+    // Placeholder text
+    std::unique_ptr<juce::Label> placeholderLabel;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CanvasPanel)
+};
@@ -1,63 +1,89 @@
-#include "PluginEditor.h"
-#include "Core/PluginProcessor.h"       // NOT "../PluginProcessor.h"
-#include "ArtefactLookAndFeel.h"
-#include "HeaderBarComponent.h"
-#include "ForgePanel.h"
-#include "../Core/Commands.h"          
-
-//==============================================================================
-ARTEFACTAudioProcessorEditor::ARTEFACTAudioProcessorEditor(ARTEFACTAudioProcessor& p)
-    : juce::AudioProcessorEditor(p),
-    audioProcessor(p)
-{
-    // Create look and feel first
-    artefactLookAndFeel = std::make_unique<ArtefactLookAndFeel>();
-    setLookAndFeel(artefactLookAndFeel.get());
-
-    // Create UI components
-    headerBar = std::make_unique<HeaderBarComponent>();
-    forgePanel = std::make_unique<ForgePanel>(p);
-
-    addAndMakeVisible(headerBar.get());
-    addAndMakeVisible(forgePanel.get());
-
-    // Add test button
-    addAndMakeVisible(testButton);
-    testButton.addListener(this);
-
-    setSize(800, 600);
-}
-
-ARTEFACTAudioProcessorEditor::~ARTEFACTAudioProcessorEditor()
-{
-    setLookAndFeel(nullptr);
-}
-
-//==============================================================================
-void ARTEFACTAudioProcessorEditor::paint(juce::Graphics& g)
-{
-    g.fillAll(getLookAndFeel().findColour(juce::ResizableWindow::backgroundColourId));
-}
-
-void ARTEFACTAudioProcessorEditor::resized()
-{
-    auto bounds = getLocalBounds();
-    const int headerH = 40;
-
-    headerBar->setBounds(bounds.removeFromTop(headerH));
-
-    // Place test button in top-right corner
-    testButton.setBounds(bounds.removeFromTop(30).removeFromRight(100).reduced(5));
-
-    forgePanel->setBounds(bounds);
-}
-
-void ARTEFACTAudioProcessorEditor::buttonClicked(juce::Button* button)
-{
-    if (button == &testButton)
-    {
-        // When the test button is clicked, push our test command to the queue.
-        audioProcessor.pushCommandToQueue(Command(ForgeCommandID::Test));
-        DBG("Test button clicked - command sent!");
-    }
-}
\ No newline at end of file
+#include "PluginEditor.h"
+#include "Core/PluginProcessor.h"       // NOT "../PluginProcessor.h"
+#include "ArtefactLookAndFeel.h"
+#include "HeaderBarComponent.h"
+#include "ForgePanel.h"
+#include "RetroCanvasComponent.h"
+#include "../Core/Commands.h"          
+
+//==============================================================================
+ARTEFACTAudioProcessorEditor::ARTEFACTAudioProcessorEditor(ARTEFACTAudioProcessor& p)
+    : juce::AudioProcessorEditor(p),
+    audioProcessor(p)
+{
+    // Create look and feel first
+    artefactLookAndFeel = std::make_unique<ArtefactLookAndFeel>();
+    setLookAndFeel(artefactLookAndFeel.get());
+
+    // Create UI components
+    headerBar = std::make_unique<HeaderBarComponent>();
+    forgePanel = std::make_unique<ForgePanel>(p);
+    paintCanvas = std::make_unique<RetroCanvasComponent>();
+
+    // Drag points go out a frame's worth at a time; single points and clicks as commands
+    paintCanvas->setCommandTarget([&p](const Command& cmd) { return p.pushCommandToQueue(cmd); });
+    paintCanvas->setStrokeSegmentTarget([&p](const StrokeSegment& segment) { return p.pushStrokeSegment(segment); });
+
+    // Dropped images and tile files become the canvas engine's spectrogram
+    canvasPanel = std::make_unique<CanvasPanel>();
+    canvasPanel->setImageTarget([&p](const juce::Image& image) { return p.requestCanvasImage(image); });
+    canvasPanel->setTiledCanvasTarget([&p](const juce::File& tileFile) { return p.requestTiledCanvas(tileFile); });
+
+    addAndMakeVisible(headerBar.get());
+    addAndMakeVisible(forgePanel.get());
+    addAndMakeVisible(paintCanvas.get());
+    addAndMakeVisible(canvasPanel.get());
+
+    // Add test button
+    addAndMakeVisible(testButton);
+    testButton.addListener(this);
+
+    setSize(1000, 700);
+    startTimerHz(15);
+}
+
+ARTEFACTAudioProcessorEditor::~ARTEFACTAudioProcessorEditor()
+{
+    stopTimer();
+    setLookAndFeel(nullptr);
+}
+
+//==============================================================================
+void ARTEFACTAudioProcessorEditor::paint(juce::Graphics& g)
+{
+    g.fillAll(getLookAndFeel().findColour(juce::ResizableWindow::backgroundColourId));
+}
+
+void ARTEFACTAudioProcessorEditor::resized()
+{
+    auto bounds = getLocalBounds();
+    const int headerH = 40;
+
+    headerBar->setBounds(bounds.removeFromTop(headerH));
+
+    // Place test button in top-right corner
+    testButton.setBounds(bounds.removeFromTop(30).removeFromRight(100).reduced(5));
+
+    forgePanel->setBounds(bounds.removeFromLeft(bounds.getWidth() * 2 / 5));
+    canvasPanel->setBounds(bounds.removeFromBottom(bounds.getHeight() / 3));
+    paintCanvas->setBounds(bounds);
+}
+
+void ARTEFACTAudioProcessorEditor::buttonClicked(juce::Button* button)
+{
+    if (button == &testButton)
+    {
+        // When the test button is clicked, push our test command to the queue.
+        audioProcessor.pushCommandToQueue(Command(ForgeCommandID::Test));
+        DBG("Test button clicked - command sent!");
+    }
+}
+
+void ARTEFACTAudioProcessorEditor::timerCallback()
+{
+    const auto& snapshot = audioProcessor.getParameterBridge().read();
+    const double sampleRate = audioProcessor.getSampleRate();
+    const float latency = sampleRate > 0.0 ? (float)(audioProcessor.getLatencySamples() / sampleRate) : 0.0f;
+
+    paintCanvas->setPerformanceInfo(snapshot.cpuLoad, snapshot.activePartials, latency);
+}
@@ -1,29 +1,42 @@
-﻿// Source/GUI/PluginEditor.h
-#pragma once
-
-#include <JuceHeader.h>
-#include "Core/Commands.h"
-#include "Core/ForgeProcessor.h"
-#include "Core/CanvasProcessor.h"
-#include "Core/ParameterBridge.h"
-#include "GUI/CanvasPanel.h"
-
-class ARTEFACTAudioProcessorEditor : public juce::AudioProcessorEditor,
-    public juce::Button::Listener,
-    public juce::Timer
-{
-public:
-    explicit ARTEFACTAudioProcessorEditor(ARTEFACTAudioProcessor&);
-    ~ARTEFACTAudioProcessorEditor() override;
-
-    void paint(juce::Graphics&) override;
-    void resized() override;
-
-    void buttonClicked(juce::Button*) override;
-    void timerCallback() override;
-
-private:
-    ARTEFACTAudioProcessor& processor;
-    std::unique_ptr<CanvasPanel> canvasPanel;
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ARTEFACTAudioProcessorEditor)
-};
+﻿// Source/GUI/PluginEditor.h
+#pragma once
+
+#include <JuceHeader.h>
+#include "Core/Commands.h"
+#include "Core/ForgeProcessor.h"
+#include "Core/CanvasProcessor.h"
+#include "Core/ParameterBridge.h"
+#include "GUI/CanvasPanel.h"
+
+class ARTEFACTAudioProcessor;
+class ArtefactLookAndFeel;
+class HeaderBarComponent;
+class ForgePanel;
+class RetroCanvasComponent;
+
+class ARTEFACTAudioProcessorEditor : public juce::AudioProcessorEditor,
+    public juce::Button::Listener,
+    public juce::Timer
+{
+public:
+    explicit ARTEFACTAudioProcessorEditor(ARTEFACTAudioProcessor&);
+    ~ARTEFACTAudioProcessorEditor() override;
+
+    void paint(juce::Graphics&) override;
+    void resized() override;
+
+    void buttonClicked(juce::Button*) override;
+    void timerCallback() override;
+
+private:
+    ARTEFACTAudioProcessor& audioProcessor;
+
+    std::unique_ptr<ArtefactLookAndFeel> artefactLookAndFeel;
+    std::unique_ptr<HeaderBarComponent>  headerBar;
+    std::unique_ptr<ForgePanel>          forgePanel;
+    std::unique_ptr<RetroCanvasComponent> paintCanvas;   // strokes go to the PaintEngine
+    std::unique_ptr<CanvasPanel> canvasPanel;
+    juce::TextButton testButton{ "TEST" };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ARTEFACTAudioProcessorEditor)
+};
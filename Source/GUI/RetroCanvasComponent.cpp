@@ -180,6 +180,9 @@ void RetroCanvasComponent::mouseWheelMove(const juce::MouseEvent& e, const juce:
 
 void RetroCanvasComponent::timerCallback()
 {
+    // Drag points gathered since the last frame go out as one segment
+    flushStrokeSegment();
+    
     // Update animation time
     animationTime += 1.0f / 60.0f;
     
@@ -646,7 +649,9 @@ void RetroCanvasComponent::updatePaintStroke(juce::Point<float> canvasPoint, flo
     lastPaintPoint = canvasPoint;
     brushPressure = pressure;
     
-    sendPaintCommand(PaintCommandID::UpdateStroke, canvasPoint, pressure);
+    pendingSegment.addPoint(canvasPoint.x, canvasPoint.y, pressure);
+    if (pendingSegment.isFull())
+        flushStrokeSegment();
 }
 
 void RetroCanvasComponent::endPaintStroke()
@@ -655,6 +660,7 @@ void RetroCanvasComponent::endPaintStroke()
         return;
     
     isPainting = false;
+    flushStrokeSegment();
     sendPaintCommand(PaintCommandID::EndStroke, {0, 0});
 }
 
@@ -667,6 +673,25 @@ void RetroCanvasComponent::sendPaintCommand(PaintCommandID commandID, juce::Poin
     }
 }
 
+void RetroCanvasComponent::flushStrokeSegment()
+{
+    if (pendingSegment.isEmpty())
+        return;
+    
+    // Without a segment target, or with every segment slot busy, fall back to one command per point
+    if (!strokeSegmentTarget || !strokeSegmentTarget(pendingSegment))
+    {
+        for (int i = 0; i < pendingSegment.numPoints; ++i)
+        {
+            const auto index = (size_t)i;
+            sendPaintCommand(PaintCommandID::UpdateStroke,
+                             { pendingSegment.x[index], pendingSegment.y[index] }, pendingSegment.pressure[index]);
+        }
+    }
+    
+    pendingSegment.clear();
+}
+
 void RetroCanvasComponent::addParticleAt(juce::Point<float> position, juce::Colour color)
 {
     Particle particle;
@@ -101,6 +101,7 @@ public:
     // Audio integration
     void setPaintEngine(PaintEngine* engine) { paintEngine = engine; }
     void setCommandTarget(std::function<bool(const Command&)> target) { commandTarget = target; }
+    void setStrokeSegmentTarget(std::function<bool(const StrokeSegment&)> target) { strokeSegmentTarget = target; }
     
     // Performance monitoring
     void setPerformanceInfo(float cpuLoad, int activeOscillators, float latency);
@@ -166,6 +167,7 @@ private:
     
     void sendPaintCommand(PaintCommandID commandID, juce::Point<float> canvasPoint, 
                          float pressure = 1.0f);
+    void flushStrokeSegment();
     
     // Visual feedback for painting
     void addParticleAt(juce::Point<float> position, juce::Colour color);
@@ -194,6 +196,8 @@ private:
     // Audio integration
     PaintEngine* paintEngine = nullptr;
     std::function<bool(const Command&)> commandTarget;
+    std::function<bool(const StrokeSegment&)> strokeSegmentTarget;
+    StrokeSegment pendingSegment;   // drag points not yet sent, flushed every frame
     
     // Performance monitoring
     float currentCPULoad = 0.0f;
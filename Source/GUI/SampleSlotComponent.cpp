@@ -1,74 +1,110 @@
-﻿// Source/GUI/SampleSlotComponent.cpp
-#include "SampleSlotComponent.h"
-#include "ArtefactLookAndFeel.h"
-#include "Core/PluginProcessor.h"
-
-// …
-
-void SampleSlotComponent::resized()
-{
-    if (isExpanded)
-    {
-        const int knob = 40, gap = 60;
-        pitchSlider.setBounds(20, 50, knob, knob);
-        speedSlider.setBounds(20 + gap, 50, knob, knob);
-        volumeSlider.setBounds(20 + gap * 2, 50, knob, knob);
-        driveSlider.setBounds(20 + gap * 3, 50, knob, knob);
-        crushSlider.setBounds(20 + gap * 4, 50, knob, knob);
-        syncButton.setBounds(getWidth() - 60, 50, 50, 25);
-
-        for (juce::Component* c : {
-            static_cast<juce::Component*>(&pitchSlider),
-            static_cast<juce::Component*>(&speedSlider),
-            static_cast<juce::Component*>(&volumeSlider),
-            static_cast<juce::Component*>(&driveSlider),
-            static_cast<juce::Component*>(&crushSlider),
-            static_cast<juce::Component*>(&syncButton)
-            })
-            c->setVisible(true);
-    }
-    else
-    {
-        for (juce::Component* c : {
-            static_cast<juce::Component*>(&pitchSlider),
-            static_cast<juce::Component*>(&speedSlider),
-            static_cast<juce::Component*>(&volumeSlider),
-            static_cast<juce::Component*>(&driveSlider),
-            static_cast<juce::Component*>(&crushSlider),
-            static_cast<juce::Component*>(&syncButton)
-            })
-            c->setVisible(false);
-    }
-}
-
-void SampleSlotComponent::mouseDown(const juce::MouseEvent& e)
-{
-    auto& v = processor.getForgeProcessor().getVoice(slotIndex);
-
-    if (e.mods.isRightButtonDown())
-    {
-        isExpanded = !isExpanded;
-        setSize(getWidth(), isExpanded ? 100 : 40);
-
-        for (juce::Component* c : {
-            static_cast<juce::Component*>(&pitchSlider),
-            static_cast<juce::Component*>(&speedSlider),
-            static_cast<juce::Component*>(&volumeSlider),
-            static_cast<juce::Component*>(&driveSlider),
-            static_cast<juce::Component*>(&crushSlider),
-            static_cast<juce::Component*>(&syncButton)
-            })
-            c->setVisible(isExpanded);
-
-        resized();
-        if (auto* p = getParentComponent()) p->resized();
-    }
-    else if (v.hasSample())
-    {
-        processor.pushCommandToQueue(
-            Command(v.isActive() ? ForgeCommandID::StopPlayback
-                : ForgeCommandID::StartPlayback,
-                slotIndex));
-    }
-    repaint();
-}
+﻿// Source/GUI/SampleSlotComponent.cpp
+#include "SampleSlotComponent.h"
+#include "ArtefactLookAndFeel.h"
+#include "Core/PluginProcessor.h"
+
+// …
+
+void SampleSlotComponent::resized()
+{
+    if (isExpanded)
+    {
+        const int knob = 40, gap = 60;
+        pitchSlider.setBounds(20, 50, knob, knob);
+        speedSlider.setBounds(20 + gap, 50, knob, knob);
+        volumeSlider.setBounds(20 + gap * 2, 50, knob, knob);
+        driveSlider.setBounds(20 + gap * 3, 50, knob, knob);
+        crushSlider.setBounds(20 + gap * 4, 50, knob, knob);
+        syncButton.setBounds(getWidth() - 60, 50, 50, 25);
+
+        for (juce::Component* c : {
+            static_cast<juce::Component*>(&pitchSlider),
+            static_cast<juce::Component*>(&speedSlider),
+            static_cast<juce::Component*>(&volumeSlider),
+            static_cast<juce::Component*>(&driveSlider),
+            static_cast<juce::Component*>(&crushSlider),
+            static_cast<juce::Component*>(&syncButton)
+            })
+            c->setVisible(true);
+    }
+    else
+    {
+        for (juce::Component* c : {
+            static_cast<juce::Component*>(&pitchSlider),
+            static_cast<juce::Component*>(&speedSlider),
+            static_cast<juce::Component*>(&volumeSlider),
+            static_cast<juce::Component*>(&driveSlider),
+            static_cast<juce::Component*>(&crushSlider),
+            static_cast<juce::Component*>(&syncButton)
+            })
+            c->setVisible(false);
+    }
+}
+
+void SampleSlotComponent::mouseDown(const juce::MouseEvent& e)
+{
+    const auto& slot = processor.getParameterBridge().read().slots[(size_t)slotIndex];
+
+    if (slot.hasSample && e.mods.isAltDown())
+    {
+        paintSpectralDab(e);
+        return;
+    }
+
+    if (e.mods.isRightButtonDown())
+    {
+        isExpanded = !isExpanded;
+        setSize(getWidth(), isExpanded ? 100 : 40);
+
+        for (juce::Component* c : {
+            static_cast<juce::Component*>(&pitchSlider),
+            static_cast<juce::Component*>(&speedSlider),
+            static_cast<juce::Component*>(&volumeSlider),
+            static_cast<juce::Component*>(&driveSlider),
+            static_cast<juce::Component*>(&crushSlider),
+            static_cast<juce::Component*>(&syncButton)
+            })
+            c->setVisible(isExpanded);
+
+        resized();
+        if (auto* p = getParentComponent()) p->resized();
+    }
+    else if (slot.hasSample && e.mods.isShiftDown())
+    {
+        // Shift-click sends the sample to the canvas as its spectrogram
+        processor.requestSlotAnalysis(slotIndex);
+    }
+    else if (slot.hasSample)
+    {
+        processor.pushCommandToQueue(
+            Command(slot.isPlaying ? ForgeCommandID::StopPlayback
+                : ForgeCommandID::StartPlayback,
+                slotIndex));
+    }
+    repaint();
+}
+
+void SampleSlotComponent::mouseDrag(const juce::MouseEvent& e)
+{
+    if (e.mods.isAltDown() && processor.getParameterBridge().read().slots[(size_t)slotIndex].hasSample)
+        paintSpectralDab(e);
+}
+
+void SampleSlotComponent::paintSpectralDab(const juce::MouseEvent& e)
+{
+    // The waveform strip doubles as the sample's spectrogram: time across, the canvas'
+    // log frequency rows down. Alt erases, alt-shift boosts, alt-cmd smears.
+    const auto area = getLocalBounds().removeFromTop(40).toFloat();
+
+    SampleSpectrum::Brush brush;
+    brush.mode = e.mods.isShiftDown()   ? SampleSpectrum::Brush::Mode::Boost
+               : e.mods.isCommandDown() ? SampleSpectrum::Brush::Mode::Smear
+                                        : SampleSpectrum::Brush::Mode::Erase;
+    brush.x = juce::jlimit(0.0f, 1.0f, (e.position.x - area.getX()) / area.getWidth());
+    brush.y = juce::jlimit(0.0f, 1.0f, (e.position.y - area.getY()) / area.getHeight());
+    brush.radiusX = 6.0f / area.getWidth();
+    brush.radiusY = 4.0f / area.getHeight();
+    brush.amount = 0.5f;
+
+    processor.requestSpectralEdit(slotIndex, brush);
+}